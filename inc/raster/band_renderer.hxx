@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file band_renderer.hxx
+/// \brief Banded rendering of display lists.
+/// \details A display list records blits and drawing primitives for a page. A band renderer plays the list back
+///          into one band-sized plane, band by band from the top of the page, and streams each finished band to a
+///          sink. Memory stays fixed at one band however tall the page.
+
+#pragma once
+
+#include "raster/bit_plane.hxx"
+#include "raster/draw.hxx"
+#include "raster/path.hxx"
+
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+namespace raster {
+
+/// \brief Default maximum scan bytes per band.
+/// \details 256 KiB fits a band within a typical level-two cache.
+inline constexpr std::size_t defaultBandScanBytes = 262144U;
+
+// DisplayList
+// ~~~~~~~~~~~
+// A display list records operations in page co-ordinates, each with the
+// page scan lines it may touch.  Playing an operation back into a band
+// moves it up by the band's first page scan line; the drawing
+// primitives clip exactly, so an operation split across bands draws the
+// same pixels as it would on the whole page.  Operations play back in
+// the order recorded.
+//
+// Blits refer to their source planes, they do not copy them.  Source
+// planes must outlive the display list.  Paths copy.
+
+/// \class DisplayList
+/// \brief Blits and drawing primitives recorded for banded playback.
+class DisplayList {
+public:
+  /// \brief Operation playing back into a band.
+  /// \details Receives the band and the page scan line of its top scan line. Answers true if anything drew.
+  using Draw = std::function<bool(BitPlane &band, int yBand)>;
+
+  /// \brief Record an operation touching page scan lines top up to but excluding bottom.
+  void add(int top, int bottom, Draw draw);
+
+  /// \brief Record a bit-block transfer with binary raster operation; see BitPlane::bitBlt().
+  void bitBlt(int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc, int xSrc, int ySrc, Rop2 rop2);
+
+  /// \brief Record a bit-block transfer with unary raster operation; see BitPlane::bitBlt().
+  void bitBlt(int x, int y, int cx, int cy, Rop1 rop1);
+
+  /// \brief Record a line; see raster::drawLine().
+  void drawLine(int x0, int y0, int x1, int y1, Rop2 rop2 = srcCopy);
+
+  /// \brief Record a rectangle outline; see raster::drawRect().
+  void drawRect(int x, int y, int cx, int cy, Rop2 rop2 = srcCopy);
+
+  /// \brief Record a filled rectangle; see raster::fillRect().
+  void fillRect(int x, int y, int cx, int cy, Rop2 rop2 = srcCopy);
+
+  /// \brief Record an ellipse outline; see raster::drawEllipse().
+  void drawEllipse(int x, int y, int rx, int ry, Rop2 rop2 = srcCopy);
+
+  /// \brief Record a filled ellipse; see raster::fillEllipse().
+  void fillEllipse(int x, int y, int rx, int ry, Rop2 rop2 = srcCopy);
+
+  /// \brief Record a thick ellipse outline; see raster::strokeEllipse().
+  void strokeEllipse(int x, int y, int rx, int ry, int width, Rop2 rop2 = srcCopy);
+
+  /// \brief Record an arc; see raster::drawArc().
+  void drawArc(int x, int y, int rx, int ry, double startAngle, double sweepAngle, Rop2 rop2 = srcCopy);
+
+  /// \brief Record a thick line; see raster::strokeLine().
+  void strokeLine(int x0, int y0, int x1, int y1, int width, LineCap lineCap = LineCap::butt, Rop2 rop2 = srcCopy);
+
+  /// \brief Record a filled path; see raster::fillPath().
+  void fillPath(const Path &path, FillRule fillRule = FillRule::nonZero, Rop2 rop2 = srcCopy);
+
+  /// \brief Remove all operations.
+  void clear() { items.clear(); }
+
+  /// \brief Answer the number of operations.
+  std::size_t size() const { return items.size(); }
+
+  friend class BandRenderer;
+
+private:
+  struct Item {
+    int top;
+    int bottom;
+    Draw draw;
+  };
+
+  std::vector<Item> items;
+};
+
+/// \brief Sink for finished bands.
+/// \details Receives each band once, top to bottom, with the page scan line of its top scan line. The last band
+///          may be shorter than the rest. Answers false to stop rendering.
+using BandSink = std::function<bool(const BitPlane &band, int yBand)>;
+
+/// \brief Band sink writing scan lines to a file or pipe.
+/// \details Writes each scan line's scan bytes in turn, the layout of a raw PBM image's pixels.
+/// \param file Open file; the sink does not close it.
+BandSink fileSink(std::FILE *file);
+
+// BandRenderer
+// ~~~~~~~~~~~~
+// A band renderer owns one band plane, the width of the page and some
+// scan lines high, and reuses it for every band of every page it
+// renders.  Rendering first sorts the display list into buckets, one
+// per band, keeping recorded order within each bucket; each band then
+// clears to the background, plays back its own bucket, and goes to the
+// sink.  Pages printing concurrently each need a renderer of their own.
+
+/// \class BandRenderer
+/// \brief Renders display lists one band at a time.
+class BandRenderer {
+public:
+  /// \brief Constructs a renderer for pages of a given size.
+  /// \param cx Page width.
+  /// \param cy Page height.
+  /// \param cyBand Scan lines per band; zero picks as many as fit within defaultBandScanBytes.
+  BandRenderer(int cx, int cy, int cyBand = 0);
+
+  /// \brief Render a display list band by band.
+  /// \param displayList Operations to play back.
+  /// \param sink Sink for each finished band.
+  /// \param background Unary raster operation clearing each band before playback.
+  /// \return True if every band reached the sink, false if the sink stopped rendering or the band plane could not
+  ///         be allocated.
+  bool render(const DisplayList &displayList, const BandSink &sink, Rop1 background = blackness);
+
+  /// \brief Answer the scan lines per band.
+  int getBandHeight() const { return cyBand; }
+
+private:
+  int width;
+  int height;
+  int cyBand;
+  BitPlane band;
+};
+
+} // namespace raster
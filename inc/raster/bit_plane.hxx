@@ -46,6 +46,18 @@
 //              | create(cx,cy)        |       +-------+
 //              | bitBlt(...,rop2)     |
 //              | bitBlt(...,rop1)     |
+//              | bitBlt(policy,...)   |
+//              | bitBltAtomic(...)    |
+//              | bitBlt(region,...)   |
+//              | setClipMask(mask)    |
+//              | operator=(expr)      |
+//              | view(x,y,cx,cy)      |
+//              | trackDamage(grain)   |
+//              | takeDamage()         |
+//              | trackOccupancy()     |
+//              | indexRows()          |
+//              | scrollRows(dy)       |
+//              | shiftBits(...,dx)    |
 //              | ~BitPlane()          |
 //              +----------------------+
 //
@@ -54,11 +66,24 @@
 //
 //**********************************************************************
 
+#include "raster/execution.hxx"
+#include "raster/geometry.hxx"
 #include "raster/rop.hxx"
 #include "raster/scan.hxx"
 
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
 namespace raster {
 
+class Region;
+
+/// \brief Base of lazy plane expressions.
+/// \details Empty tag; see plane_expr.hxx.
+struct PlaneExpr {};
+
 /// \class BitPlane
 /// \brief Represents a two-dimensional bit-plane for binary image operations.
 ///
@@ -93,10 +118,60 @@ public:
   /// \param v Pointer to the bit-plane scan bytes.
   BitPlane(int cx, int cy, scanbyte v[]);
 
+  /// \brief Parameterised constructor with stride.
+  /// \param cx Width of the bit-plane.
+  /// \param cy Height of the bit-plane.
+  /// \param v Pointer to the bit-plane scan bytes.
+  /// \param widthScanBytes Scan bytes from one scan line to the next; at least enough for the width.
+  BitPlane(int cx, int cy, scanbyte v[], int widthScanBytes);
+
   /// \brief Copy constructor.
+  /// \details Copies scan bytes that the copy owns. A static copy shares them instead and starts without an
+  ///          occupancy summary; writes through it must be touch()ed on the original, which cannot see them.
   /// \param copy Bit-plane to copy.
   BitPlane(const BitPlane &copy);
 
+  /// \brief Move constructor.
+  /// \param move Bit-plane to move; left empty.
+  BitPlane(BitPlane &&move) noexcept;
+
+  /// \brief Copy assignment.
+  /// \details Same sense as the copy constructor: copies dynamic scan bytes, shares static ones. Assigning a plane
+  ///          does not blit its bits into existing storage; use bitBlt() or a plane expression for that.
+  /// \param copy Bit-plane to copy.
+  BitPlane &operator=(const BitPlane &copy);
+
+  /// \brief Move assignment.
+  /// \param move Bit-plane to move; left empty.
+  BitPlane &operator=(BitPlane &&move) noexcept;
+
+  /// \brief Assign a lazy plane expression.
+  /// \details Evaluates the expression in one fused pass over the whole plane. See plane_expr.hxx.
+  /// \param expr Plane expression, e.g. (a & ~b) | (c ^ d).
+  template <typename Expr>
+    requires std::is_base_of_v<PlaneExpr, Expr>
+  BitPlane &operator=(const Expr &expr) {
+    (void)assign(0, 0, width, height, expr);
+    return *this;
+  }
+
+  /// \brief Assign a lazy plane expression to a rectangle.
+  /// \details Clips like bitBlt(): the rectangle against this plane and every operand against its plane. Evaluates
+  ///          the expression one scan line at a time, storing each scan byte once. An operand may be this plane
+  ///          at the same origin as the destination rectangle. Defined in plane_expr.hxx.
+  /// \return True if successful, false if nothing was assigned.
+  template <typename Expr> bool assign(int x, int y, int cx, int cy, Expr expr);
+
+  /// \brief Make a zero-copy view of a rectangle.
+  /// \details The view shares this plane's scan bytes. Its left edge rounds down to a scan byte boundary, so pixel
+  ///          (x, y) of this plane is pixel (x & 7, 0) of the view. Clips to this plane. Stops tracking occupancy
+  ///          on this plane, since writes through the view bypass its summary.
+  /// \return View, or an empty plane if the rectangle misses this plane.
+  BitPlane view(int x, int y, int cx, int cy);
+
+  /// \brief Swap two bit-planes.
+  void swap(BitPlane &other) noexcept;
+
   /// \brief Create a new dynamic memory allocated bit-plane.
   /// \param cx Width of the bit-plane.
   /// \param cy Height of the bit-plane.
@@ -124,6 +199,174 @@ public:
   /// \return True if successful, false otherwise.
   bool bitBlt(int x, int y, int cx, int cy, Rop1 rop1);
 
+  /// \brief Sequenced bit-block transfer with binary raster operation.
+  /// \details Same as the overload without a policy.
+  bool bitBlt(const execution::sequenced_policy &policy, int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc,
+              int xSrc, int ySrc, Rop2 rop2);
+
+  /// \brief Sequenced bit-block transfer with unary raster operation.
+  /// \details Same as the overload without a policy.
+  bool bitBlt(const execution::sequenced_policy &policy, int x, int y, int cx, int cy, Rop1 rop1);
+
+  /// \brief Parallel bit-block transfer with binary raster operation.
+  /// \details Partitions the clipped destination rectangle into bands of scan lines and transfers the bands
+  ///          concurrently. Results match the sequenced transfer unless source and destination overlap.
+  /// \param policy Parallel execution policy, e.g. execution::par or execution::par_unseq.
+  /// \return True if successful, false otherwise.
+  bool bitBlt(const execution::parallel_policy &policy, int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc,
+              int xSrc, int ySrc, Rop2 rop2);
+
+  /// \brief Parallel bit-block transfer with unary raster operation.
+  /// \param policy Parallel execution policy, e.g. execution::par or execution::par_unseq.
+  /// \return True if successful, false otherwise.
+  bool bitBlt(const execution::parallel_policy &policy, int x, int y, int cx, int cy, Rop1 rop1);
+
+  /// \brief Bit-block transfer with atomic edge stores.
+  /// \details Stores the edge scan bytes of each scan line with atomic fetch-or, fetch-and or fetch-xor so that
+  ///          threads can blit concurrently into one plane. Destination rectangles of concurrent blits may share
+  ///          edge scan bytes but must not otherwise overlap.
+  /// \param rop2 Raster operation: srcPaint, srcAnd or srcInvert.
+  /// \return True if successful, false if nothing transferred or the raster operation has no atomic form.
+  bool bitBltAtomic(int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc, int xSrc, int ySrc, Rop2 rop2);
+
+  /// \brief Bit-block transfer with binary raster operation, clipped against a region.
+  /// \details Transfers only destination bits within the region as well as both planes. Sets up the transfer
+  ///          once however many rectangles the region has. See region.hxx.
+  /// \param region Clip region in destination co-ordinates.
+  /// \return True if anything transferred, false otherwise.
+  bool bitBlt(const Region &region, int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc, int xSrc, int ySrc,
+              Rop2 rop2);
+
+  /// \brief Bit-block transfer with unary raster operation, clipped against a region.
+  /// \param region Clip region in destination co-ordinates.
+  /// \return True if anything transferred, false otherwise.
+  bool bitBlt(const Region &region, int x, int y, int cx, int cy, Rop1 rop1);
+
+  /// \brief Attach or detach a clip mask.
+  /// \details Drawing then changes only pixels where the mask has ones; pixels beyond the mask never change. The
+  ///          mask is in this plane's co-ordinates and must outlive the attachment. Operations writing whole scan
+  ///          bytes of their own ignore the mask: reduce(), neighbourhood(), BitSlicedCounter::threshold() and
+  ///          the frameDiff() delta. Row operations move whole scan lines regardless.
+  /// \param clipMask Clip mask, or nullptr to detach.
+  void setClipMask(const BitPlane *clipMask);
+
+  /// \brief Get the clip mask.
+  /// \return Attached clip mask, or nullptr if none.
+  const BitPlane *getClipMask() const { return clipMask; }
+
+  /// \brief Turn uniform-source detection on or off.
+  /// \details With detection on, binary blits into this plane first test each source scan line for all zeros or
+  ///          all ones; where uniform, the raster operation collapses to a fill. Off by default. Source lines that
+  ///          the source's occupancy summary shows empty need no scan.
+  void detectUniformSources(bool detect) { detectingUniform = detect; }
+
+  /// \brief Start tracking damage.
+  /// \details From now on, every bitBlt(), fill, plane expression or other write marks the cells of a grid covered
+  ///          by its clipped destination rectangle. Tracking starts with no damage. Creating the plane afresh
+  ///          damages it all.
+  /// \param grain Cell size; a non-positive extent selects the default.
+  void trackDamage(Grain grain = {});
+
+  /// \brief Stop tracking damage and discard any.
+  void untrackDamage();
+
+  /// \brief Answer true if tracking damage.
+  bool isTrackingDamage() const { return trackingDamage; }
+
+  /// \brief Take the damage.
+  /// \details Coalesces the damaged cells into rectangles, as frameDiff() does, then clears the damage.
+  /// \return Rectangles covering every write since tracking started or damage last cleared.
+  std::vector<Rect> takeDamage();
+
+  /// \brief Clear the damage without taking it.
+  void clearDamage();
+
+  /// \brief Start tracking occupancy.
+  /// \details Builds a two-level summary of which scan words hold set pixels: one bit per scan word, one bit per
+  ///          scan line above that. Writes keep the summary up to date; queries skip empty scan words and lines.
+  ///          Writers through the non-const bits() must touch() what they write, or the summary goes stale. Static
+  ///          copies sharing the scan bytes start without tracking; writes through them must be touch()ed on
+  ///          the original.
+  void trackOccupancy();
+
+  /// \brief Stop tracking occupancy and discard the summary.
+  void untrackOccupancy();
+
+  /// \brief Answer true if tracking occupancy.
+  bool isTrackingOccupancy() const { return trackingOccupancy; }
+
+  /// \brief Answer false if scan line y certainly has no set pixels.
+  /// \details Always true without tracking.
+  bool isRowOccupied(int y) const;
+
+  /// \brief Answer false if a scan word certainly has no set pixels.
+  /// \details Always true without tracking.
+  /// \param y Scan line.
+  /// \param offset Scan byte offset of the word within the scan line, a multiple of eight.
+  bool isWordOccupied(int y, std::size_t offset) const;
+
+  /// \brief Find the first scan line at or below y that may have set pixels.
+  /// \return Scan line, or the height if none.
+  int nextOccupiedRow(int y) const;
+
+  /// \brief Start indexing scan lines through a row table.
+  /// \details Scan lines then lie wherever the table points, so scrolling, inserting, deleting, swapping and
+  ///          flipping scan lines move row pointers rather than scan bytes. Blits, plane expressions and queries
+  ///          find every scan line through the table. Views of an indexed plane copy its table as it stands.
+  ///          Creating the plane afresh re-indexes it.
+  /// \return True if indexing, false if the plane is empty.
+  bool indexRows();
+
+  /// \brief Stop indexing, moving the scan lines back into top-down order.
+  /// \return True if successful; false for views of an indexed plane, whose scan lines belong to another plane.
+  bool unindexRows();
+
+  /// \brief Answer true if indexing scan lines.
+  bool isIndexingRows() const { return rowTable != nullptr; }
+
+  /// \brief Scroll vertically.
+  /// \details Scan line y afterwards shows what scan line y - dy showed; scan lines leaving one edge enter at the
+  ///          other. Constant time unless tracking occupancy. Requires indexing.
+  /// \return True if successful, false if not indexing.
+  bool scrollRows(int dy);
+
+  /// \brief Insert clear scan lines, moving scan lines at and below y down; the bottom cy scan lines drop off.
+  /// \return True if successful, false if not indexing or y lies outside the plane.
+  bool insertRows(int y, int cy = 1);
+
+  /// \brief Delete scan lines, moving scan lines below them up; clear scan lines enter at the bottom.
+  /// \return True if successful, false if not indexing or y lies outside the plane.
+  bool deleteRows(int y, int cy = 1);
+
+  /// \brief Swap two scan lines.
+  /// \return True if successful, false if not indexing or either lies outside the plane.
+  bool swapRows(int y0, int y1);
+
+  /// \brief Flip the plane upside down.
+  /// \return True if successful, false if not indexing.
+  bool flipRows();
+
+  /// \brief Shift a rectangle's pixels horizontally in place.
+  /// \details Pixel x of each scan line in the rectangle takes the pixel at x - dx, so positive dx shifts right.
+  ///          Pixels shifted out of the rectangle either vanish, leaving clear pixels behind, or wrap around to
+  ///          the other side. Negative extents put the origin at the rectangle's far edge, as for bitBlt().
+  ///          Clips the rectangle to this plane first; with a clip mask, only pixels where the mask is set change.
+  /// \param dx Shift in pixels.
+  /// \param wrap True to rotate rather than shift.
+  /// \return True if anything remains after clipping, false otherwise.
+  bool shiftBits(int x, int y, int cx, int cy, int dx, bool wrap = false);
+
+  /// \brief Record a write.
+  /// \details Operations call this after clipping and writing. Operations writing scan bytes directly through
+  ///          bits() must call it themselves. Writes through a view() neither damage nor occupy this plane. Safe to
+  ///          call concurrently for disjoint scan lines.
+  void touch(int x, int y, int cx, int cy) {
+    if (trackingDamage)
+      recordDamage(x, y, cx, cy);
+    if (trackingOccupancy)
+      settleOccupancy(x, y, cx, cy);
+  }
+
   /// \brief Destructor.
   /// \details Destroys the bit-plane and releases any allocated resources.
   ~BitPlane() {
@@ -151,18 +394,129 @@ protected:
   scanbyte *store = nullptr; ///< Pointer to the bit-plane scan bytes.
   bool autoDelete = false;   ///< Flag indicating whether to delete the bit-plane.
 
+  bool trackingDamage = false;      ///< Flag indicating whether to track damage.
+  Grain damageGrain;                ///< Damage cell size.
+  int damageColumns = 0;            ///< Damage cells per row.
+  std::vector<std::uint8_t> damage; ///< Damage cells, non-zero where damaged.
+
+  const BitPlane *clipMask = nullptr; ///< Clip mask, or nullptr.
+  bool detectingUniform = false;      ///< Flag indicating whether to detect uniform sources.
+
+  /// \brief Clip extents to the clip mask.
+  /// \return True if anything remains, false otherwise.
+  bool clipExtent(int x, int y, int &cx, int &cy) const;
+
+  bool trackingOccupancy = false;          ///< Flag indicating whether to track occupancy.
+  std::size_t occupancyStride = 0;         ///< Occupancy words per scan line.
+  std::vector<std::uint64_t> occupancy;    ///< Occupancy: one bit per scan word.
+  std::vector<std::uint64_t> occupiedRows; ///< Occupancy: one bit per scan line.
+
+  /// \brief Recompute the occupancy of the scan words covered by a rectangle.
+  void settleOccupancy(int x, int y, int cx, int cy);
+
+  /// \brief Record a concurrent write: damage, and occupancy without reading the scan bytes.
+  void mark(int x, int y, int cx, int cy);
+
+  std::vector<scanbyte *> rowPointers; ///< Row table twice over, a ring; empty unless indexing.
+  int rowOrigin = 0;                   ///< Row table origin within the ring.
+  scanbyte **rowTable = nullptr;       ///< Row table from its origin, or nullptr.
+
+  /// \brief Copy row table entries from the origin's side of the ring to the other side.
+  void mirrorRows(int y, int cy);
+
+  /// \brief Permute a span of the row table, carrying damage and occupancy along.
+  template <typename Permute> void permuteRows(int y, int cy, Permute permute);
+
+  /// \brief Reorder occupancy: scan line y + i takes the summary of scan line order[i].
+  void permuteOccupancy(int y, const std::vector<int> &order);
+
+  /// \brief Mark the damage cells covered by a rectangle.
+  void recordDamage(int x, int y, int cx, int cy);
+
+  /// \brief Size the damage grid to the plane.
+  void resizeDamage(std::uint8_t cell);
+
   /// \brief Find the scan byte containing the bit at the specified coordinates.
   /// \param x X-coordinate of the bit.
   /// \param y Y-coordinate of the bit.
   /// \return Pointer to the scan byte containing the bit, or nullptr if out of bounds.
   scanbyte *findBits(int x, int y) const;
 
+  /// \brief Clip a transfer rectangle against this plane and a source plane.
+  /// \details Normalises negative extents then clips in-place.
+  /// \return True if anything remains to transfer, false otherwise.
+  bool clip(int &x, int &y, int &cx, int &cy, const BitPlane &bitPlaneSrc, int &xSrc, int &ySrc) const;
+
+  /// \brief Transfer a clipped rectangle.
+  /// \details Runs the fetch-logic-store loop without clipping; see clip().
+  void transfer(int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc, int xSrc, int ySrc, Rop2 rop2);
+
+  /// \brief Fill a clipped rectangle with a raster operation that ignores its source.
+  void fill(int x, int y, int cx, int cy, Rop2 rop2);
+
+  /// \brief Transfer a clipped rectangle, filling where source scan lines are uniform.
+  void transferUniform(int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc, int xSrc, int ySrc, Rop2 rop2);
+
+  /// \brief Classify a scan line span.
+  /// \return 0 if all zeros, 1 if all ones, -1 if mixed.
+  int uniformity(int x, int y, int cx) const;
+
+  /// \brief Transfer a clipped rectangle using a given Blt functor.
+  template <typename BltFunctor>
+  void transfer(BltFunctor &blt, int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc, int xSrc, int ySrc);
+
+  /// \brief Transfer a clipped rectangle, clipped further against a region.
+  /// \return True if anything transferred, false otherwise.
+  template <typename BltFunctor>
+  bool transfer(BltFunctor &blt, const Region &region, int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc,
+                int xSrc, int ySrc);
+
+  /// \brief Transfer a clipped rectangle using a Blt functor already phase-aligned for the origins.
+  template <typename BltFunctor>
+  void transferRows(BltFunctor &blt, int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc, int xSrc, int ySrc);
+
 public:
   /// \brief Get a pointer to the bits at the specified coordinates.
   /// \param x X-coordinate of the bits.
   /// \param y Y-coordinate of the bits.
   /// \return Pointer to the bits at the specified coordinates.
   const scanbyte *bits(int x, int y) const;
+
+  /// \brief Get a pointer to the bits at the specified coordinates for writing.
+  /// \details Operations that write scan bytes directly bypass bitBlt(); they own clipping, and must touch() the
+  ///          rectangle they write so that damage and occupancy see it.
+  /// \param x X-coordinate of the bits.
+  /// \param y Y-coordinate of the bits.
+  /// \return Pointer to the bits at the specified coordinates.
+  scanbyte *bits(int x, int y);
 };
 
+// BitPlane::findBits(x,y)
+// ~~~~~~~~~~~~~~~~~~~~~~~
+// Given the co-ordinate of a bit, findBits returns the address of its
+// scan byte.  The calculation assumes one bit per pixel and scan byte-aligned
+// scan lines --- BitPlane class constraints.  Expression x & 7 gives
+// the bit's position within the scan byte; where 0 corresponds to the most
+// significant bit, 7 to bit zero.  The x and y co-ordinates aren't
+// clipped.  FindBits is a protected helper.  It lives in the header so
+// that operations outside this class's translation unit can inline it.
+// Indexed planes look scan lines up in their row table.
+
+inline scanbyte *BitPlane::findBits(int x, int y) const {
+  return (rowTable != nullptr ? rowTable[y] : store + widthScanBytes * y) + (x >> 3);
+}
+
+inline const scanbyte *BitPlane::bits(int x, int y) const { return findBits(x, y); }
+
+inline scanbyte *BitPlane::bits(int x, int y) { return findBits(x, y); }
+
+inline bool BitPlane::isRowOccupied(int y) const {
+  return !trackingOccupancy || ((occupiedRows[y >> 6] >> (y & 63)) & 1U) != 0U;
+}
+
+inline bool BitPlane::isWordOccupied(int y, std::size_t offset) const {
+  const std::size_t word = offset >> 3;
+  return !trackingOccupancy || ((occupancy[occupancyStride * y + (word >> 6)] >> (word & 63U)) & 1U) != 0U;
+}
+
 } // namespace raster
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file bit_sliced_counter.hxx
+/// \brief Per-pixel counters stored as a stack of bit planes.
+/// \details This file contains the declaration of the BitSlicedCounter class. A k-bit counter keeps one bit plane
+///          per counter bit; adding a bit plane to the counter ripples carries from plane to plane, 64 pixels per
+///          scan-word operation.
+
+#pragma once
+
+#include "raster/bit_plane.hxx"
+
+#include <vector>
+
+namespace raster {
+
+// BitSlicedCounter
+// ~~~~~~~~~~~~~~~~
+// Counting hits per pixel with 8-bit images costs eight bits per pixel
+// and a byte-wide read-modify-write per hit.  A bit-sliced counter stores
+// the same counts as k bit planes, slice i holding bit i of every
+// pixel's count.  Adding a binary plane is then a k-stage ripple-carry
+// adder run on whole scan words: sum = a ^ b ^ carry, carry = majority.
+// Words where the addend is zero skip the adder entirely, so sparse
+// updates cost little more than reading the addend.
+//
+// Counts wrap modulo 2 to the k by default.  In saturating mode, counts
+// stick at 2 to the k minus one, all slices set.
+
+/// \class BitSlicedCounter
+/// \brief Per-pixel counters as bit-plane slices.
+class BitSlicedCounter {
+public:
+  /// \brief Default constructor.
+  /// \details Constructs an empty counter: zero width, zero height, no slices.
+  BitSlicedCounter() = default;
+
+  /// \brief Create zeroed counters.
+  /// \param cx Width in pixels.
+  /// \param cy Height in pixels.
+  /// \param bitCount Number of counter bits, i.e. slices; between 1 and 32.
+  /// \return True if successful, false otherwise.
+  bool create(int cx, int cy, int bitCount);
+
+  /// \brief Zero all counts.
+  void clear();
+
+  /// \brief Enable or disable saturating arithmetic.
+  void setSaturating(bool saturate) { saturating = saturate; }
+
+  /// \brief Answer true if arithmetic saturates rather than wraps.
+  bool isSaturating() const { return saturating; }
+
+  /// \brief Add one where the mask is set.
+  /// \param mask Binary plane with the counter's width and height.
+  /// \return True if successful, false if geometry differs.
+  bool increment(const BitPlane &mask) { return add(mask, 1U); }
+
+  /// \brief Add a value where the mask is set.
+  /// \param mask Binary plane with the counter's width and height.
+  /// \param value Amount to add to each masked count.
+  /// \return True if successful, false if geometry differs.
+  bool add(const BitPlane &mask, unsigned value);
+
+  /// \brief Add other counts pixel by pixel.
+  /// \param counter Counter with the same width and height; its bit count may differ.
+  /// \return True if successful, false if geometry differs.
+  bool add(const BitSlicedCounter &counter);
+
+  /// \brief Compare counts with a threshold.
+  /// \details Sets each destination bit where the count is at least the threshold, clears it otherwise. Bits
+  ///          beyond the destination's width remain unchanged.
+  /// \param bitPlane Destination plane with the counter's width and height.
+  /// \param threshold Threshold count.
+  /// \return True if successful, false if geometry differs.
+  bool threshold(BitPlane &bitPlane, unsigned threshold) const;
+
+  /// \brief Get one pixel's count.
+  unsigned count(int x, int y) const;
+
+  /// \brief Get a slice, i.e. the plane of counter bit i.
+  const BitPlane &slice(int i) const { return slices[i]; }
+
+  int getWidth() const { return width; }
+  int getHeight() const { return height; }
+  int getBitCount() const { return static_cast<int>(slices.size()); }
+
+private:
+  int width = 0;
+  int height = 0;
+  bool saturating = false;
+  std::vector<BitPlane> slices;
+};
+
+} // namespace raster
@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file blit_queue.hxx
+/// \brief Asynchronous blit queue.
+/// \details This file contains the declaration of the BlitQueue class, which runs bit-plane work on background
+///          worker threads and answers futures or, for C++20 coroutines, awaitables.
+
+#pragma once
+
+#include "raster/bit_plane.hxx"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__cpp_impl_coroutine)
+#include <coroutine>
+#endif
+
+namespace raster {
+
+// BlitQueue
+// ~~~~~~~~~
+// A blit queue owns a pool of worker threads.  Work submitted for a
+// destination plane runs in submission order, one item at a time; work
+// for different planes runs in parallel on different workers.  Every
+// destination plane has a ``strand,'' a first-in first-out queue of
+// work.  A strand with work waits in the ready queue until a worker
+// picks it up; the worker runs the strand's first item then puts the
+// strand back at the end of the ready queue if more work remains.
+//
+// Submitted work refers to its planes, it does not copy them.  Planes
+// must outlive their work.  Source planes must not change while work
+// reads them, unless they are the destination of earlier work on the
+// same strand.  Destroying the queue first drains all outstanding work.
+
+/// \class BlitQueue
+/// \brief Runs blits and fills on background workers.
+class BlitQueue {
+public:
+  /// \brief Work for a destination plane.
+  /// \details Answers true on success, like BitPlane::bitBlt().
+  using Work = std::function<bool(BitPlane &bitPlane)>;
+
+  /// \brief Constructs a queue with worker threads.
+  /// \param workers Number of worker threads; zero means one per hardware thread.
+  explicit BlitQueue(unsigned workers = 0U);
+
+  BlitQueue(const BlitQueue &) = delete;
+  BlitQueue &operator=(const BlitQueue &) = delete;
+
+  /// \brief Destructor.
+  /// \details Drains outstanding work then joins the workers.
+  ~BlitQueue();
+
+  /// \brief Submit work for a destination plane.
+  /// \param bitPlane Destination plane; its strand orders the work.
+  /// \param work Work to run on a worker thread.
+  /// \return Future answering the work's result, or rethrowing the work's exception.
+  std::future<bool> submit(BitPlane &bitPlane, Work work);
+
+  /// \brief Submit a bit-block transfer with binary raster operation.
+  /// \return Future answering the result of BitPlane::bitBlt().
+  std::future<bool> bitBlt(BitPlane &bitPlane, int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc, int xSrc,
+                           int ySrc, Rop2 rop2);
+
+  /// \brief Submit a bit-block transfer with unary raster operation, i.e. a fill.
+  /// \return Future answering the result of BitPlane::bitBlt().
+  std::future<bool> bitBlt(BitPlane &bitPlane, int x, int y, int cx, int cy, Rop1 rop1);
+
+  /// \brief Wait until all submitted work completes.
+  /// \details Awaited work counts as complete before its coroutine resumes, so a resumed coroutine may wait too.
+  void wait();
+
+#if defined(__cpp_impl_coroutine)
+  /// \brief Awaitable work.
+  /// \details Submits its work when awaited; the awaiting coroutine resumes on the worker thread after the work
+  ///          completes and after the worker releases the strand, so the coroutine may submit or await more work
+  ///          for the same plane. Resuming rethrows any exception thrown by the work. The coroutine must not
+  ///          destroy the queue, since the destructor would join the worker running it.
+  class Awaitable {
+  public:
+    Awaitable(BlitQueue &queue, BitPlane &bitPlane, Work work)
+        : queue(queue), bitPlane(bitPlane), work(std::move(work)) {}
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) {
+      queue.enqueue(
+          bitPlane,
+          [this] {
+            try {
+              result = work(bitPlane);
+            } catch (...) {
+              exception = std::current_exception();
+            }
+          },
+          [handle] { handle.resume(); });
+    }
+    bool await_resume() const {
+      if (exception)
+        std::rethrow_exception(exception);
+      return result;
+    }
+
+  private:
+    BlitQueue &queue;
+    BitPlane &bitPlane;
+    Work work;
+    bool result = false;
+    std::exception_ptr exception;
+  };
+
+  /// \brief Schedule work for a coroutine.
+  /// \return Awaitable answering the work's result.
+  Awaitable schedule(BitPlane &bitPlane, Work work) { return {*this, bitPlane, std::move(work)}; }
+#endif
+
+private:
+  struct Item {
+    std::function<void()> run;  // runs on the strand
+    std::function<void()> then; // runs after releasing the strand
+  };
+  using Strand = std::deque<Item>;
+
+  void enqueue(BitPlane &bitPlane, std::function<void()> run, std::function<void()> then = nullptr);
+  void work();
+
+  std::mutex mutex;
+  std::condition_variable readyCondition;
+  std::condition_variable idleCondition;
+  std::unordered_map<const BitPlane *, Strand> strands;
+  std::deque<const BitPlane *> ready;
+  std::size_t pending = 0U;
+  bool stopping = false;
+  std::vector<std::thread> workers;
+};
+
+} // namespace raster
@@ -25,10 +25,37 @@
 #include "phase_align.hxx"
 #include "rop.hxx"
 
+#include <atomic>
 #include <cassert>
 
 namespace raster {
 
+// ropLogic(rop2, d, s)
+// ~~~~~~~~~~~~~~~~~~~~
+// A Rop2 code is a four-entry truth table.  Bit D+2S of the code gives
+// the result for destination bit D and source bit S, e.g. srcPaint
+// (DSo) is 1110 binary: zero only where both D and S are zero.  Given
+// a constant code the compiler folds ropLogic down to the equivalent
+// Boolean expression; it serves the operations that combine operands
+// without a Blt functor.
+
+constexpr scanbyte ropLogic(Rop2 rop2, scanbyte d, scanbyte s) {
+  scanbyte r = 0x00U;
+  if (rop2 & 1)
+    r |= ~d & ~s;
+  if (rop2 & 2)
+    r |= d & ~s;
+  if (rop2 & 4)
+    r |= ~d & s;
+  if (rop2 & 8)
+    r |= d & s;
+  return r;
+}
+
+static_assert(ropLogic(srcPaint, 0xf0U, 0xccU) == 0xfcU);
+static_assert(ropLogic(srcErase, 0xf0U, 0xccU) == 0x0cU);
+static_assert(ropLogic(ropDSna, 0xf0U, 0xccU) == 0x30U);
+
 // Blt functor
 // ~~~ ~~~~~~~
 // The Blt class encapsulates blit behaviour in a functor object.  Blt
@@ -84,4 +111,56 @@ public:
   scanbyte *store = nullptr;        // store: *store
 };
 
+// AtomicBlt functor
+// ~~~~~~~~~ ~~~~~~~
+// AtomicBlt stores masked scan bytes atomically.  Masked stores happen
+// at the left and right edges of a blit where neighbouring blits may
+// share the same scan byte; an ordinary read-modify-write would lose
+// the other blit's bits.  Three raster operations have atomic forms:
+// DSo (srcPaint) becomes fetch-or, DSa (srcAnd) fetch-and, DSx (src-
+// Invert) fetch-xor.  Zeros in the mask leave destination bits alone:
+// OR and XOR with zero, or AND with one.  Unmasked stores in the inter-
+// ior remain ordinary fetch-logic-stores.
+
+class AtomicBlt : public Blt {
+public:
+  AtomicBlt(Rop2 rop2) : Blt(rop2), rop2(rop2) {
+    assert(rop2 == srcPaint || rop2 == srcAnd || rop2 == srcInvert);
+  }
+  void fetchLogicStore(scanbyte mask) {
+    std::atomic_ref<scanbyte> d(*store++);
+    const scanbyte s = fetch();
+    switch (rop2) {
+    case srcAnd:
+      d.fetch_and(static_cast<scanbyte>(~mask | s));
+      break;
+    case srcInvert:
+      d.fetch_xor(mask & s);
+      break;
+    default:
+      d.fetch_or(mask & s);
+    }
+  }
+  void fetchLogicStore() { Blt::fetchLogicStore(); }
+  Rop2 rop2;
+};
+
+// ClipBlt functor
+// ~~~~~~~ ~~~~~~~
+// ClipBlt stores only where a clip mask has ones.  The clip mask is a
+// bit plane in destination co-ordinates, so its scan bytes are always
+// in phase with the destination: no shifting, one extra load per scan
+// byte.  Every store becomes a masked store, the edge mask ANDed with
+// the clip scan byte.  The source still fetches for every scan byte so
+// that phase alignment keeps step.  The base functor supplies the
+// store, ordinary or atomic.
+
+template <typename Base> class ClipBlt : public Base {
+public:
+  using Base::Base;
+  void fetchLogicStore(scanbyte mask) { Base::fetchLogicStore(static_cast<scanbyte>(mask & *clip++)); }
+  void fetchLogicStore() { Base::fetchLogicStore(*clip++); }
+  const scanbyte *clip = nullptr; // clip: *clip
+};
+
 } // namespace raster
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file bounds.hxx
+/// \brief Content bounding boxes and trimming.
+/// \details The bounding box of a plane's content is the least rectangle containing every set pixel, or every clear
+///          pixel. Trimming answers a zero-copy view of the bounding box, skipping empty margins before encoding or
+///          transmission.
+
+#pragma once
+
+#include "raster/bit_plane.hxx"
+#include "raster/geometry.hxx"
+
+namespace raster {
+
+/// \brief Find the bounding box of set, or clear, pixels.
+/// \param bitPlane Plane to search.
+/// \param set True to bound the set pixels, false to bound the clear pixels.
+/// \return Least rectangle containing every such pixel; an empty rectangle if none.
+Rect boundingBox(const BitPlane &bitPlane, bool set = true);
+
+/// \brief Trim a plane to its content.
+/// \details Answers a view of the bounding box; see BitPlane::view(). The view's left edge rounds down to a scan
+///          byte boundary, so up to seven empty columns may remain on the left.
+/// \param bitPlane Plane to trim; the view shares its scan bytes.
+/// \param set True to trim to the set pixels, false to the clear pixels.
+/// \return View of the content, or an empty plane if none.
+BitPlane trim(BitPlane &bitPlane, bool set = true);
+
+} // namespace raster
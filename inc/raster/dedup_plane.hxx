@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file dedup_plane.hxx
+/// \brief Tiled planes storing identical tiles once.
+/// \details Scanned forms and generated pages repeat tiles: blank areas, logos, table rules. A deduplicating plane
+///          hashes its tiles and keeps one copy of each distinct tile in a content-addressed store, so memory scales
+///          with unique content rather than page area.
+
+#pragma once
+
+#include "raster/bit_plane.hxx"
+#include "raster/tile_grid.hxx"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace raster {
+
+// TileStore
+// ~~~~~~~~~
+// A tile store indexes immutable tiles by a 64-bit hash of their scan
+// bytes.  Interning a tile answers the stored tile with the same bits
+// if there is one, otherwise stores the new tile.  Planes hold tiles
+// by shared pointer; the index holds them weakly, so a tile lives just
+// as long as some plane uses it.  Several planes may share one store,
+// e.g. the pages of a document.  Stores and their planes are not safe
+// to use from several threads at once.
+
+/// \class TileStore
+/// \brief Content-addressed store of immutable tiles.
+class TileStore {
+public:
+  /// \brief Immutable tile.
+  struct Tile {
+    std::uint64_t hash;
+    std::vector<scanbyte> bits;
+  };
+
+  /// \brief Answer the stored tile with the given bits, storing them if new.
+  std::shared_ptr<const Tile> intern(std::vector<scanbyte> bits);
+
+  /// \brief Number of distinct live tiles.
+  std::size_t size() const;
+
+private:
+  void purge();
+
+  std::unordered_multimap<std::uint64_t, std::weak_ptr<const Tile>> index;
+  std::size_t purgeSize = 64U;
+};
+
+// DedupPlane
+// ~~~~~~~~~~
+// A deduplicating plane is a grid of shared, immutable tiles.  Writing
+// to a tile copies it, blits into the copy, then interns the copy: if
+// the result matches a stored tile, including the tile's own previous
+// contents, the plane shares that tile and drops the copy.  Sharing
+// therefore survives until a write actually changes a tile, and two
+// tiles written to the same contents end up shared again.  Filling a
+// whole tile with zeros or ones skips the copy; the plane keeps its
+// all-zeros and all-ones tiles for that purpose.  Copying a plane
+// copies its tile pointers, so copies share every tile until written.
+
+/// \class DedupPlane
+/// \brief Tiled plane with copy-on-write, content-addressed tiles.
+class DedupPlane {
+public:
+  /// \brief Constructs an empty plane using a store.
+  /// \param store Tile store, possibly shared with other planes.
+  explicit DedupPlane(std::shared_ptr<TileStore> store = std::make_shared<TileStore>()) : store(std::move(store)) {}
+
+  /// \brief Create a blank plane; every tile shares one blank tile.
+  /// \param tileSize Tile size in pixels; rounds up to a multiple of eight.
+  /// \return True if successful, false otherwise.
+  bool create(int cx, int cy, int tileSize = defaultTileSize);
+
+  int getWidth() const { return grid.width; }
+  int getHeight() const { return grid.height; }
+  int getTileSize() const { return grid.tileSize; }
+
+  /// \brief Bit-block transfer into this plane with binary raster operation.
+  /// \details Clips like BitPlane::bitBlt(). Tiles that the transfer leaves unchanged stay shared.
+  /// \return True if successful, false otherwise.
+  bool bitBlt(int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc, int xSrc, int ySrc, Rop2 rop2);
+
+  /// \brief Bit-block transfer into this plane with unary raster operation.
+  /// \return True if any tile changed, false otherwise.
+  bool bitBlt(int x, int y, int cx, int cy, Rop1 rop1);
+
+  /// \brief Bit-block transfer out of this plane.
+  /// \details Same as bitPlaneDst.bitBlt(x, y, cx, cy, *this, xSrc, ySrc, rop2) would be, tile by tile.
+  /// \return True if anything transferred, false otherwise.
+  bool render(BitPlane &bitPlaneDst, int x, int y, int cx, int cy, int xSrc, int ySrc, Rop2 rop2) const;
+
+  /// \brief Number of tiles in the grid.
+  std::size_t tileCount() const { return tiles.size(); }
+
+  /// \brief Number of distinct tiles the plane uses.
+  std::size_t uniqueTileCount() const;
+
+private:
+  std::shared_ptr<const TileStore::Tile> uniformTile(bool set);
+
+  std::shared_ptr<TileStore> store;
+  TileGrid grid;
+  std::vector<std::shared_ptr<const TileStore::Tile>> tiles;
+  std::shared_ptr<const TileStore::Tile> uniformTiles[2];
+};
+
+} // namespace raster
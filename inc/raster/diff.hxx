@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file diff.hxx
+/// \brief Frame differences as dirty rectangles.
+/// \details Comparing the previous and current frames of a display answers the rectangles that need pushing to the
+///          display. Differences collect on a grid of cells, whose size matches the display's granularity: whole
+///          scan bytes, pages of scan lines, and so on. Dirty cells then coalesce into rectangles.
+
+#pragma once
+
+#include "raster/bit_plane.hxx"
+#include "raster/geometry.hxx"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace raster {
+
+/// \brief Coalesce a grid of dirty cells into rectangles.
+/// \details Horizontally adjacent dirty cells merge into one rectangle; rectangles in successive rows of cells merge
+///          when their columns match exactly. Rectangles append in order of their top edges.
+/// \param cells Grid of cells in row order, non-zero for dirty.
+/// \param columns Number of cells per row.
+/// \param cx Plane width, for clipping the right-most cells.
+/// \param cy Plane height, for clipping the bottom cells.
+/// \param grain Cell size.
+/// \param rects Rectangles to append to.
+void coalesce(std::span<const std::uint8_t> cells, int columns, int cx, int cy, Grain grain, std::vector<Rect> &rects);
+
+/// \brief Compare two frames.
+/// \param previous Previous frame.
+/// \param current Current frame, the same size as the previous frame.
+/// \param dirty Rectangles covering every changed pixel, replacing any previous contents.
+/// \param grain Cell size; a non-positive extent selects the default.
+/// \param delta Optional plane receiving previous XOR current; created to match the frames' size.
+/// \return True if the frames have the same size; false otherwise, answering no rectangles.
+bool frameDiff(const BitPlane &previous, const BitPlane &current, std::vector<Rect> &dirty, Grain grain = {},
+               BitPlane *delta = nullptr);
+
+} // namespace raster
@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file draw.hxx
+/// \brief Lines, spans, rectangles, ellipses and thick strokes.
+/// \details Drawing primitives write straight to a plane's scan bytes rather than blitting one pixel at a time.
+///          They draw with ink: a binary raster operation applied as if the source were all ones. So srcCopy and
+///          srcPaint set pixels, ropDSna clears them, srcInvert inverts them. Drawing clips to the plane and to its
+///          clip mask, and records the write like any blit.
+
+#pragma once
+
+#include "raster/bit_plane.hxx"
+
+namespace raster {
+
+// SpanWriter
+// ~~~~~~~~~~
+// A span writer fills horizontal spans of a plane with ink: masked
+// scan bytes at either end, whole scan words between.  Shape drawing
+// breaks shapes into spans and hands them to a writer.  The writer
+// collects the extent of everything written and touches the plane
+// once, when finished or destroyed, rather than once per span.
+
+/// \class SpanWriter
+/// \brief Fills horizontal spans with ink.
+class SpanWriter {
+public:
+  SpanWriter(BitPlane &bitPlane, Rop2 rop2);
+  SpanWriter(const SpanWriter &) = delete;
+  SpanWriter &operator=(const SpanWriter &) = delete;
+  ~SpanWriter() { finish(); }
+
+  /// \brief Fill pixels x0 up to but excluding x1 of scan line y.
+  /// \details Clips to the plane and its clip mask.
+  /// \return True if anything remains after clipping, false otherwise.
+  bool span(int x0, int x1, int y);
+
+  /// \brief Fill pixels y0 up to but excluding y1 of column x.
+  /// \return True if anything remains after clipping, false otherwise.
+  bool column(int x, int y0, int y1);
+
+  /// \brief Record the writes so far with the plane; see BitPlane::touch().
+  void finish();
+
+private:
+  BitPlane &bitPlane;
+  const BitPlane *clipMask;
+  Rop2 ink;
+  int cx;     // clipping width
+  int cy;     // clipping height
+  int left;   // extent written
+  int top;    //
+  int right;  //
+  int bottom; //
+};
+
+/// \brief Fill a horizontal span of pixels x up to x + cx on scan line y.
+/// \return True if anything drew, false otherwise.
+bool drawSpan(BitPlane &bitPlane, int x, int y, int cx, Rop2 rop2 = srcCopy);
+
+/// \brief Draw a vertical line of pixels y up to y + cy in column x.
+/// \return True if anything drew, false otherwise.
+bool drawVLine(BitPlane &bitPlane, int x, int y, int cy, Rop2 rop2 = srcCopy);
+
+/// \brief Draw a one-pixel line from x0, y0 to x1, y1 inclusive.
+/// \details Draws the same pixels in either direction, each pixel once, so drawing a line twice with srcInvert
+///          restores the plane.
+/// \return True if anything drew, false otherwise.
+bool drawLine(BitPlane &bitPlane, int x0, int y0, int x1, int y1, Rop2 rop2 = srcCopy);
+
+/// \brief Draw the one-pixel outline of a rectangle, each pixel once.
+/// \return True if anything drew, false otherwise.
+bool drawRect(BitPlane &bitPlane, int x, int y, int cx, int cy, Rop2 rop2 = srcCopy);
+
+/// \brief Fill a rectangle.
+/// \return True if anything drew, false otherwise.
+bool fillRect(BitPlane &bitPlane, int x, int y, int cx, int cy, Rop2 rop2 = srcCopy);
+
+/// \brief Shapes for the ends of thick strokes.
+enum class LineCap {
+  butt,   ///< Ends square at the end points.
+  square, ///< Ends square, half the width beyond the end points.
+  round   ///< Ends in half-discs centred on the end points.
+};
+
+/// \brief Draw the one-pixel outline of an ellipse centred on x, y with radii rx and ry, each pixel once.
+/// \details Radii clamp to 16383.
+/// \return True if anything drew, false otherwise.
+bool drawEllipse(BitPlane &bitPlane, int x, int y, int rx, int ry, Rop2 rop2 = srcCopy);
+
+/// \brief Fill an ellipse centred on x, y with radii rx and ry.
+/// \return True if anything drew, false otherwise.
+bool fillEllipse(BitPlane &bitPlane, int x, int y, int rx, int ry, Rop2 rop2 = srcCopy);
+
+/// \brief Draw the outline of an ellipse width pixels thick, centred on the one-pixel outline.
+/// \return True if anything drew, false otherwise.
+bool strokeEllipse(BitPlane &bitPlane, int x, int y, int rx, int ry, int width, Rop2 rop2 = srcCopy);
+
+/// \brief Draw part of an ellipse's one-pixel outline.
+/// \details Angles run in degrees anticlockwise as seen, from the positive x axis; a negative sweep runs
+///          clockwise. Angles are those of the ellipse's parametric form, so a quarter sweep covers a quadrant.
+/// \param startAngle Angle at which the arc starts.
+/// \param sweepAngle Angle through which the arc sweeps.
+/// \return True if anything drew, false otherwise.
+bool drawArc(BitPlane &bitPlane, int x, int y, int rx, int ry, double startAngle, double sweepAngle,
+             Rop2 rop2 = srcCopy);
+
+/// \brief Draw the one-pixel outline of a circle.
+inline bool drawCircle(BitPlane &bitPlane, int x, int y, int r, Rop2 rop2 = srcCopy) {
+  return drawEllipse(bitPlane, x, y, r, r, rop2);
+}
+
+/// \brief Fill a circle.
+inline bool fillCircle(BitPlane &bitPlane, int x, int y, int r, Rop2 rop2 = srcCopy) {
+  return fillEllipse(bitPlane, x, y, r, r, rop2);
+}
+
+/// \brief Draw a line width pixels thick from pixel centre x0, y0 to x1, y1.
+/// \details Fills the pixels whose centres lie within half the width of the line, capped at either end, each
+///          pixel once.
+/// \return True if anything drew, false otherwise.
+bool strokeLine(BitPlane &bitPlane, int x0, int y0, int x1, int y1, int width, LineCap lineCap = LineCap::butt,
+                Rop2 rop2 = srcCopy);
+
+} // namespace raster
@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file execution.hxx
+/// \brief Execution policies for bit-plane operations.
+/// \details Policies mirror those of std::execution: seq runs on the calling thread; par and par_unseq partition
+///          the scan lines into bands and run the bands on separate threads. A policy's grain sets the minimum
+///          number of scan bytes per band so that small operations never pay for threads.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace raster::execution {
+
+/// \brief Default minimum number of scan bytes per band.
+/// \details 16 KiB approximates one core's share of a level-one data cache.
+inline constexpr std::size_t minGrainScanBytes = 16384U;
+
+/// \brief Sequenced execution policy.
+/// \details Operations run on the calling thread, top-to-bottom.
+struct sequenced_policy {};
+
+/// \brief Parallel execution policy.
+/// \details Operations run in bands of whole scan lines, one thread per band.
+struct parallel_policy {
+  /// \brief Minimum scan bytes per band.
+  std::size_t grain = minGrainScanBytes;
+};
+
+/// \brief Parallel unsequenced execution policy.
+/// \details Bit-plane operations work on whole scan bytes at a time, so unsequenced execution adds nothing over
+///          parallel execution; the policy exists for symmetry with std::execution.
+struct parallel_unsequenced_policy : parallel_policy {};
+
+inline constexpr sequenced_policy seq{};
+inline constexpr parallel_policy par{};
+inline constexpr parallel_unsequenced_policy par_unseq{};
+
+/// \brief Band function.
+/// \details Receives the first scan line of the band relative to the start of the operation, and the number of
+///          scan lines in the band.
+using Band = std::function<void(int y, int cy)>;
+
+/// \brief Run a band function once over all scan lines.
+/// \param policy Sequenced execution policy.
+/// \param cy Number of scan lines.
+/// \param scanBytes Scan bytes per scan line.
+/// \param band Band function.
+inline void forEachBand(const sequenced_policy &policy, int cy, std::size_t scanBytes, const Band &band) {
+  (void)policy;
+  (void)scanBytes;
+  if (cy > 0)
+    band(0, cy);
+}
+
+/// \brief Partition scan lines into bands and run the band function concurrently.
+/// \details The number of bands never exceeds the hardware concurrency, nor the number of scan lines, nor the total
+///          scan bytes divided by the policy grain. One band runs on the calling thread. The function returns after
+///          all bands complete.
+/// \param policy Parallel execution policy.
+/// \param cy Number of scan lines.
+/// \param scanBytes Scan bytes per scan line.
+/// \param band Band function.
+void forEachBand(const parallel_policy &policy, int cy, std::size_t scanBytes, const Band &band);
+
+} // namespace raster::execution
@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file geometry.hxx
+/// \brief Points and rectangles for bit-plane geometry.
+
+#pragma once
+
+namespace raster {
+
+/// \brief Pixel co-ordinate.
+struct Point {
+  int x = 0;
+  int y = 0;
+  friend bool operator==(const Point &, const Point &) = default;
+};
+
+/// \brief Rectangle: origin and extent.
+/// \details Extents follow bitBlt(): the rectangle covers columns x up to but excluding x + cx, likewise rows.
+struct Rect {
+  int x = 0;
+  int y = 0;
+  int cx = 0;
+  int cy = 0;
+  bool empty() const { return cx <= 0 || cy <= 0; }
+  friend bool operator==(const Rect &, const Rect &) = default;
+};
+
+/// \brief Cell size for dirty rectangles.
+/// \details Dirty rectangles cover whole cells, clipped to the plane. The default, eight columns by one scan line,
+///          gives rectangles aligned to scan bytes.
+struct Grain {
+  int cx = 8;
+  int cy = 1;
+};
+
+} // namespace raster
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file neighbourhood.hxx
+/// \brief 3x3 neighbourhood rules over bit planes.
+/// \details Counts the eight neighbours of every pixel with bit-sliced adders, 64 pixels per scan word, then maps
+///          each pixel's state and count to its next state through a rule table. Runs Life-like cellular automata
+///          and count-based filters such as isolated-pixel removal.
+
+#pragma once
+
+#include "raster/bit_plane.hxx"
+#include "raster/execution.hxx"
+
+namespace raster {
+
+/// \brief Treatment of neighbours beyond the plane's borders.
+enum Edge {
+  edgeZero,  ///< Pixels beyond the borders are clear.
+  edgeClamp, ///< Pixels beyond the borders repeat the nearest border pixel.
+  edgeWrap,  ///< The plane wraps around at its borders, i.e. toroidal.
+};
+
+/// \brief Rule table for 3x3 neighbourhoods.
+/// \details Bit n of birth says whether a clear pixel with n set neighbours becomes set; bit n of survival says
+///          whether a set pixel with n set neighbours stays set. Counts run from 0 to 8.
+struct NeighbourRule {
+  unsigned birth = 0U;
+  unsigned survival = 0U;
+
+  /// \brief Conway's Game of Life, B3/S23.
+  static constexpr NeighbourRule life() { return {1U << 3, 1U << 2 | 1U << 3}; }
+
+  /// \brief Isolated-pixel removal: set pixels survive with at least one set neighbour; nothing is born.
+  static constexpr NeighbourRule despeckle() { return {0U, 0x1feU}; }
+};
+
+/// \brief Apply a neighbourhood rule.
+/// \details Reads the source and writes the next state to the destination. Bits beyond the destination's width
+///          remain unchanged.
+/// \param bitPlane Destination plane; same size as the source but not the source itself.
+/// \param bitPlaneSrc Source plane.
+/// \param rule Rule table.
+/// \param edge Treatment of neighbours beyond the borders.
+/// \return True if successful, false if the planes differ in size, coincide or are empty.
+bool neighbourhood(BitPlane &bitPlane, const BitPlane &bitPlaneSrc, NeighbourRule rule, Edge edge = edgeZero);
+
+/// \brief Apply a neighbourhood rule on the calling thread.
+bool neighbourhood(const execution::sequenced_policy &policy, BitPlane &bitPlane, const BitPlane &bitPlaneSrc,
+                   NeighbourRule rule, Edge edge = edgeZero);
+
+/// \brief Apply a neighbourhood rule in parallel bands of scan lines.
+bool neighbourhood(const execution::parallel_policy &policy, BitPlane &bitPlane, const BitPlane &bitPlaneSrc,
+                   NeighbourRule rule, Edge edge = edgeZero);
+
+} // namespace raster
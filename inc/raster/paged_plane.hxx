@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file paged_plane.hxx
+/// \brief Tiled planes paged to a backing file.
+/// \details Plot jobs can produce planes larger than memory. A paged plane keeps its tiles in a backing file and
+///          only a bounded number of them in memory, so the working set rather than the plane size limits memory.
+
+#pragma once
+
+#include "raster/bit_plane.hxx"
+#include "raster/tile_grid.hxx"
+
+#include <cstddef>
+#include <cstdio>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace raster {
+
+// PagedPlane
+// ~~~~~~~~~~
+// Tiles live in slots of a backing file, tile by tile in grid order.
+// A least-recently-used cache holds the resident tiles; acquiring a
+// tile beyond the cache's capacity evicts the least recently used,
+// writing it back first if dirty.  Tiles never written have no slot
+// contents yet and read as zeros without touching the file or the
+// cache.  Blits, renders and queries work one tile at a time, so one
+// resident tile suffices for any operation; a larger cache helps
+// operations that revisit tiles.
+//
+// Operations answer false when the backing file fails to read or
+// write.  A plane may not be copied.
+
+/// \class PagedPlane
+/// \brief Tiled plane with a backing file and a bounded tile cache.
+class PagedPlane {
+public:
+  /// \brief Default number of resident tiles.
+  static constexpr std::size_t defaultCacheTiles = 64U;
+
+  PagedPlane() = default;
+  PagedPlane(const PagedPlane &) = delete;
+  PagedPlane &operator=(const PagedPlane &) = delete;
+
+  /// \brief Destructor.
+  /// \details Writes back dirty tiles if the backing file has a path, then closes it.
+  ~PagedPlane();
+
+  /// \brief Create a blank plane.
+  /// \param cacheTiles Maximum number of resident tiles; at least one.
+  /// \param path Backing file path, truncated if it exists; null for an anonymous temporary file.
+  /// \param tileSize Tile size in pixels; rounds up to a multiple of eight.
+  /// \return True if successful, false otherwise.
+  bool create(int cx, int cy, std::size_t cacheTiles = defaultCacheTiles, const char *path = nullptr,
+              int tileSize = defaultTileSize);
+
+  int getWidth() const { return grid.width; }
+  int getHeight() const { return grid.height; }
+  int getTileSize() const { return grid.tileSize; }
+
+  /// \brief Bit-block transfer into this plane with binary raster operation.
+  /// \details Clips like BitPlane::bitBlt().
+  /// \return True if successful, false otherwise.
+  bool bitBlt(int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc, int xSrc, int ySrc, Rop2 rop2);
+
+  /// \brief Bit-block transfer into this plane with unary raster operation.
+  /// \return True if successful, false otherwise.
+  bool bitBlt(int x, int y, int cx, int cy, Rop1 rop1);
+
+  /// \brief Bit-block transfer out of this plane.
+  /// \details Same as bitPlaneDst.bitBlt(x, y, cx, cy, *this, xSrc, ySrc, rop2) would be, tile by tile.
+  /// \return True if anything transferred, false otherwise.
+  bool render(BitPlane &bitPlaneDst, int x, int y, int cx, int cy, int xSrc, int ySrc, Rop2 rop2);
+
+  /// \brief Visit every tile in grid order.
+  /// \param visit Called as visit(tile, xTile, yTile) with a read-only plane of the tile's pixels within this plane
+  ///        and the tile's origin.
+  /// \return True if every tile loaded, false otherwise.
+  template <typename Visit> bool visitTiles(Visit &&visit);
+
+  /// \brief Bounding box of set or clear pixels, tile by tile.
+  /// \return Box in plane co-ordinates; empty if none, or if a tile fails to load.
+  Rect boundingBox(bool set = true);
+
+  /// \brief Write back dirty tiles.
+  /// \return True if successful, false otherwise.
+  bool flush();
+
+  /// \brief Number of tiles in memory.
+  std::size_t residentTileCount() const { return cache.size(); }
+
+private:
+  struct Entry {
+    int tile;
+    std::vector<scanbyte> bits;
+    bool dirty;
+  };
+
+  void close();
+  Entry *acquire(int tile, bool load);
+  const scanbyte *tileBits(int tile);
+  bool writeBack(Entry &entry);
+
+  TileGrid grid;
+  std::size_t cacheTiles = defaultCacheTiles;
+  std::FILE *file = nullptr;
+  bool persistent = false;
+  std::list<Entry> cache; // most recently used first
+  std::unordered_map<int, std::list<Entry>::iterator> resident;
+  std::vector<bool> stored; // slot holds the tile
+  std::vector<scanbyte> blank;
+};
+
+template <typename Visit> bool PagedPlane::visitTiles(Visit &&visit) {
+  for (int i = 0; i < grid.tileCount(); ++i) {
+    const scanbyte *bits = tileBits(i);
+    if (bits == nullptr)
+      return false;
+    const int xTile = i % grid.columns * grid.tileSize;
+    const int yTile = i / grid.columns * grid.tileSize;
+    BitPlane tile(grid.tileSize, grid.tileSize, const_cast<scanbyte *>(bits));
+    const BitPlane part = tile.view(0, 0, grid.width - xTile, grid.height - yTile);
+    visit(part, xTile, yTile);
+  }
+  return true;
+}
+
+} // namespace raster
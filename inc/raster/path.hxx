@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file path.hxx
+/// \brief Paths: polygons and Bézier curves filled by scan line.
+/// \details A path collects straight and curved segments in sub-pixel co-ordinates. Filling a path walks an active
+///          edge table down the scan lines of a plane, or of one band of a taller page, and fills the spans inside
+///          the path by the even-odd or non-zero winding rule.
+
+#pragma once
+
+#include "raster/bit_plane.hxx"
+#include "raster/geometry.hxx"
+
+#include <cstddef>
+#include <vector>
+
+namespace raster {
+
+/// \brief Rule deciding which pixels lie inside a path.
+enum class FillRule {
+  evenOdd, ///< Inside where a ray crosses the path an odd number of times.
+  nonZero  ///< Inside where the path winds around a non-zero number of times.
+};
+
+/// \brief Tolerance in pixels between a curve and its straight segments.
+inline constexpr double defaultFlatness = 0.25;
+
+// Path
+// ~~~~
+// A path is a list of sub-paths, each a list of vertices.  Curves
+// flatten into straight segments as they arrive, so a path holds only
+// vertices.  Filling closes every sub-path implicitly.
+//
+// Pixel x, y lies inside a path if its centre x + 0.5, y + 0.5 does.
+// A centre lying exactly on an edge counts as inside if the edge is
+// a left or top edge, so paths sharing an edge never both fill it,
+// and a rectangle from x0, y0 to x1, y1 with integer corners fills
+// exactly the pixels that fillRect() fills.
+
+/// \class Path
+/// \brief Polygons and flattened Bézier curves.
+class Path {
+public:
+  /// \brief Constructs an empty path.
+  /// \param flatness Tolerance in pixels for flattening curves.
+  explicit Path(double flatness = defaultFlatness) : flatness(flatness) {}
+
+  /// \brief Start a new sub-path at x, y.
+  void moveTo(double x, double y);
+
+  /// \brief Add a straight segment to x, y.
+  /// \details Starts a sub-path at x, y if none has started.
+  void lineTo(double x, double y);
+
+  /// \brief Add a cubic Bézier curve through control points x1, y1 and x2, y2 to x3, y3.
+  void curveTo(double x1, double y1, double x2, double y2, double x3, double y3);
+
+  /// \brief Close the current sub-path.
+  /// \details Segments following a close continue from the start of the closed sub-path.
+  void close();
+
+  /// \brief Remove all sub-paths.
+  void clear();
+
+  /// \brief Answer true if the path has no vertices.
+  bool empty() const { return vertices.empty(); }
+
+  /// \brief Answer the pixels that filling might touch.
+  Rect bounds() const;
+
+  friend bool fillPath(BitPlane &bitPlane, const Path &path, FillRule fillRule, Rop2 rop2, int yBand);
+
+private:
+  struct Vertex {
+    double x;
+    double y;
+  };
+
+  double flatness;
+  std::vector<Vertex> vertices;
+  std::vector<std::size_t> starts; // index of each sub-path's first vertex
+};
+
+/// \brief Fill a path.
+/// \details The plane may hold one band of a taller page; its top scan line is scan line yBand of the page. Only
+///          edges crossing the band take part.
+/// \param bitPlane Plane or band to fill.
+/// \param path Path in page co-ordinates.
+/// \param fillRule Rule deciding which pixels lie inside the path.
+/// \param rop2 Binary raster operation giving the ink; see SpanWriter.
+/// \param yBand Page scan line of the plane's top scan line.
+/// \return True if anything drew, false otherwise.
+bool fillPath(BitPlane &bitPlane, const Path &path, FillRule fillRule = FillRule::nonZero, Rop2 rop2 = srcCopy,
+              int yBand = 0);
+
+} // namespace raster
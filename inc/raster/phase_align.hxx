@@ -56,7 +56,7 @@ public:
   {                        // phase-aligned scan byte and steps
     return *store++;       // along the scan line.
   }
-  scanbyte *store = nullptr;
+  const scanbyte *store = nullptr;
 };
 
 class RightShift : public PhaseAlign {
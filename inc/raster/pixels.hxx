@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file pixels.hxx
+/// \brief Enumeration of set pixels and horizontal runs.
+/// \details Iterators and bulk extractors visit set pixels, or runs of set pixels, in scan order. They skip zero
+///          scan words whole and find set bits by counting leading zeros, so cost tracks the number of set pixels
+///          or runs rather than the plane's area.
+
+#pragma once
+
+#include "raster/bit_plane.hxx"
+#include "raster/execution.hxx"
+#include "raster/geometry.hxx"
+
+#include <cstddef>
+#include <iterator>
+#include <span>
+
+namespace raster {
+
+/// \brief Horizontal run of set pixels.
+/// \details Pixels x0 up to but excluding x1 of scan line y are set.
+struct Run {
+  int y = 0;
+  int x0 = 0;
+  int x1 = 0;
+  friend bool operator==(const Run &, const Run &) = default;
+};
+
+/// \brief Find the first set pixel at or after x on scan line y.
+/// \return Its column, or the plane's width if none.
+int nextSet(const BitPlane &bitPlane, int x, int y);
+
+/// \brief Find the first clear pixel at or after x on scan line y.
+/// \return Its column, or the plane's width if none.
+int nextClear(const BitPlane &bitPlane, int x, int y);
+
+/// \class SetPixels
+/// \brief Range of the set pixels of a bit plane, in scan order.
+class SetPixels {
+public:
+  class iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Point;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Point *;
+    using reference = const Point &;
+    iterator() = default;
+    iterator(const BitPlane &bitPlane, Point point) : bitPlane(&bitPlane), point(point) {}
+    reference operator*() const { return point; }
+    pointer operator->() const { return &point; }
+    iterator &operator++() {
+      advance(point.x + 1);
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator copy(*this);
+      ++*this;
+      return copy;
+    }
+    friend bool operator==(const iterator &lhs, const iterator &rhs) { return lhs.point == rhs.point; }
+    void advance(int x);
+
+  private:
+    const BitPlane *bitPlane = nullptr;
+    Point point{0, 0};
+  };
+
+  explicit SetPixels(const BitPlane &bitPlane) : bitPlane(bitPlane) {}
+  iterator begin() const {
+    iterator it(bitPlane, {0, 0});
+    it.advance(0);
+    return it;
+  }
+  iterator end() const { return iterator(bitPlane, {0, bitPlane.getHeight()}); }
+
+private:
+  const BitPlane &bitPlane;
+};
+
+/// \class SetRuns
+/// \brief Range of the horizontal runs of set pixels of a bit plane, in scan order.
+class SetRuns {
+public:
+  class iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Run;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Run *;
+    using reference = const Run &;
+    iterator() = default;
+    iterator(const BitPlane &bitPlane, Run run) : bitPlane(&bitPlane), run(run) {}
+    reference operator*() const { return run; }
+    pointer operator->() const { return &run; }
+    iterator &operator++() {
+      advance(run.x1);
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator copy(*this);
+      ++*this;
+      return copy;
+    }
+    friend bool operator==(const iterator &lhs, const iterator &rhs) { return lhs.run == rhs.run; }
+    void advance(int x);
+
+  private:
+    const BitPlane *bitPlane = nullptr;
+    Run run;
+  };
+
+  explicit SetRuns(const BitPlane &bitPlane) : bitPlane(bitPlane) {}
+  iterator begin() const {
+    iterator it(bitPlane, {0, 0, 0});
+    it.advance(0);
+    return it;
+  }
+  iterator end() const { return iterator(bitPlane, {bitPlane.getHeight(), 0, 0}); }
+
+private:
+  const BitPlane &bitPlane;
+};
+
+/// \brief Structure-of-arrays buffer for pixel co-ordinates.
+/// \details The capacity is the smaller of the two spans.
+struct PixelBuffer {
+  std::span<int> x;
+  std::span<int> y;
+};
+
+/// \brief Structure-of-arrays buffer for runs.
+/// \details The capacity is the smallest of the three spans.
+struct RunBuffer {
+  std::span<int> y;
+  std::span<int> x0;
+  std::span<int> x1;
+};
+
+/// \brief Extract the co-ordinates of all set pixels in scan order.
+/// \details Writes as many as fit in the buffer.
+/// \return Number of set pixels, which may exceed the buffer's capacity.
+std::size_t extractPixels(const BitPlane &bitPlane, PixelBuffer buffer);
+
+/// \brief Extract set pixels on the calling thread.
+std::size_t extractPixels(const execution::sequenced_policy &policy, const BitPlane &bitPlane, PixelBuffer buffer);
+
+/// \brief Extract set pixels in parallel bands of scan lines.
+/// \details Counts per scan line in a first parallel pass, then writes at the resulting offsets in a second.
+std::size_t extractPixels(const execution::parallel_policy &policy, const BitPlane &bitPlane, PixelBuffer buffer);
+
+/// \brief Extract all runs of set pixels in scan order.
+/// \details Writes as many as fit in the buffer.
+/// \return Number of runs, which may exceed the buffer's capacity.
+std::size_t extractRuns(const BitPlane &bitPlane, RunBuffer buffer);
+
+/// \brief Extract runs on the calling thread.
+std::size_t extractRuns(const execution::sequenced_policy &policy, const BitPlane &bitPlane, RunBuffer buffer);
+
+/// \brief Extract runs in parallel bands of scan lines.
+/// \details Counts per scan line in a first parallel pass, then writes at the resulting offsets in a second.
+std::size_t extractRuns(const execution::parallel_policy &policy, const BitPlane &bitPlane, RunBuffer buffer);
+
+} // namespace raster
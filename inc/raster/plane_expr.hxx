@@ -0,0 +1,283 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file plane_expr.hxx
+/// \brief Lazy Boolean expressions over bit planes.
+/// \details Operators &, |, ^ and ~ on bit planes build expression trees rather than computing anything.
+///          Assigning an expression to a bit plane evaluates the whole tree in a single pass, one scan line at a
+///          time, without temporary planes.
+
+#pragma once
+
+#include "raster/bit_plane.hxx"
+#include "raster/blt.hxx"
+#include "raster/phase_align.hxx"
+
+#include <algorithm>
+#include <concepts>
+
+namespace raster {
+
+// Plane expressions
+// ~~~~~ ~~~~~~~~~~~
+// Computing out = (a & ~b) | (c ^ d) with blits takes several passes
+// through temporary planes.  Plane expressions fuse the passes.  The
+// operators build a tree of expression nodes by value; the leaves
+// refer to their planes.  Assignment walks the destination scan lines,
+// and for each scan byte fetches one phase-aligned scan byte from every
+// leaf then combines them with ropLogic, the same Boolean functions as
+// the binary raster operations.  Operators fold a negated right-hand
+// operand into the raster operation, e.g. a & ~b becomes DSna.
+//
+// Every node answers the same small protocol:
+//
+//              offset(dx, dy)          moves operand origins
+//              getLeft(), getTop()     gives the least operand origin
+//              getWidth(), getHeight() gives the least operand extent
+//              bind(x)                 selects phase alignment for x
+//              prefetch(row)           starts a scan line
+//              fetch()                 fetches the next scan byte
+//
+// By default, a plane operand's origin is 0, 0, so operands line up
+// with the destination rectangle.  Function at(plane, x, y) moves an
+// operand's origin; assignment phase-aligns every operand separately.
+
+/// \class PlaneOperand
+/// \brief Leaf of a plane expression: a bit-plane at an origin.
+class PlaneOperand : public PlaneExpr {
+public:
+  PlaneOperand(const BitPlane &bitPlane, int x = 0, int y = 0) : bitPlane(&bitPlane), x(x), y(y) {}
+  PlaneOperand(const PlaneOperand &copy) : PlaneExpr(copy), bitPlane(copy.bitPlane), x(copy.x), y(copy.y) {}
+  void offset(int dx, int dy) {
+    x += dx;
+    y += dy;
+  }
+  int getLeft() const { return x; }
+  int getTop() const { return y; }
+  int getWidth() const { return bitPlane->getWidth() - x; }
+  int getHeight() const { return bitPlane->getHeight() - y; }
+  void bind(int xDst) {
+    const int shiftCount = (xDst & 7) - (x & 7);
+    if (shiftCount < 0) {
+      fetchLeftShift.shiftCount = -shiftCount;
+      phaseAlign = &fetchLeftShift;
+    } else if (shiftCount == 0)
+      phaseAlign = &fetchInPhase;
+    else {
+      fetchRightShift.shiftCount = shiftCount;
+      phaseAlign = &fetchRightShift;
+    }
+  }
+  void prefetch(int row) {
+    phaseAlign->store = bitPlane->bits(x, y + row);
+    phaseAlign->prefetch();
+  }
+  scanbyte fetch() { return phaseAlign->fetch(); }
+
+private:
+  const BitPlane *bitPlane;
+  int x;
+  int y;
+  PhaseAlign fetchInPhase;
+  RightShift fetchRightShift;
+  LeftShift fetchLeftShift;
+  PhaseAlign *phaseAlign = nullptr;
+};
+
+/// \class PlaneNot
+/// \brief Plane expression inverting its operand.
+template <typename Operand> class PlaneNot : public PlaneExpr {
+public:
+  explicit PlaneNot(const Operand &operand) : operand(operand) {}
+  void offset(int dx, int dy) { operand.offset(dx, dy); }
+  int getLeft() const { return operand.getLeft(); }
+  int getTop() const { return operand.getTop(); }
+  int getWidth() const { return operand.getWidth(); }
+  int getHeight() const { return operand.getHeight(); }
+  void bind(int xDst) { operand.bind(xDst); }
+  void prefetch(int row) { operand.prefetch(row); }
+  scanbyte fetch() { return static_cast<scanbyte>(~operand.fetch()); }
+  Operand operand;
+};
+
+/// \class PlaneRop2
+/// \brief Plane expression combining two operands with a binary raster operation.
+/// \details The left operand plays the part of the destination D, the right the source S.
+template <Rop2 rop2, typename Lhs, typename Rhs> class PlaneRop2 : public PlaneExpr {
+public:
+  PlaneRop2(const Lhs &lhs, const Rhs &rhs) : lhs(lhs), rhs(rhs) {}
+  void offset(int dx, int dy) {
+    lhs.offset(dx, dy);
+    rhs.offset(dx, dy);
+  }
+  int getLeft() const { return std::min(lhs.getLeft(), rhs.getLeft()); }
+  int getTop() const { return std::min(lhs.getTop(), rhs.getTop()); }
+  int getWidth() const { return std::min(lhs.getWidth(), rhs.getWidth()); }
+  int getHeight() const { return std::min(lhs.getHeight(), rhs.getHeight()); }
+  void bind(int xDst) {
+    lhs.bind(xDst);
+    rhs.bind(xDst);
+  }
+  void prefetch(int row) {
+    lhs.prefetch(row);
+    rhs.prefetch(row);
+  }
+  scanbyte fetch() {
+    const scanbyte d = lhs.fetch();
+    return ropLogic(rop2, d, rhs.fetch());
+  }
+  Lhs lhs;
+  Rhs rhs;
+};
+
+/// \brief Bit-plane or plane expression.
+template <typename T>
+concept PlaneTerm = std::same_as<T, BitPlane> || std::derived_from<T, PlaneExpr>;
+
+/// \brief Plane operand at an origin.
+/// \param bitPlane Operand plane.
+/// \param x Horizontal origin within the operand plane.
+/// \param y Vertical origin within the operand plane.
+inline PlaneOperand at(const BitPlane &bitPlane, int x, int y) { return {bitPlane, x, y}; }
+
+/// \brief Expression node for a term: planes become operands at 0, 0; expressions stay as they are.
+inline PlaneOperand planeExpr(const BitPlane &bitPlane) { return PlaneOperand(bitPlane); }
+template <typename Expr>
+  requires std::derived_from<Expr, PlaneExpr>
+const Expr &planeExpr(const Expr &expr) {
+  return expr;
+}
+
+template <PlaneTerm T> using PlaneExprOf = std::remove_cvref_t<decltype(planeExpr(std::declval<const T &>()))>;
+
+template <PlaneTerm T> PlaneNot<PlaneExprOf<T>> operator~(const T &term) {
+  return PlaneNot<PlaneExprOf<T>>(planeExpr(term));
+}
+
+template <PlaneTerm L, PlaneTerm R> PlaneRop2<ropDSa, PlaneExprOf<L>, PlaneExprOf<R>> operator&(const L &l, const R &r) {
+  return {planeExpr(l), planeExpr(r)};
+}
+
+template <PlaneTerm L, PlaneTerm R> PlaneRop2<ropDSo, PlaneExprOf<L>, PlaneExprOf<R>> operator|(const L &l, const R &r) {
+  return {planeExpr(l), planeExpr(r)};
+}
+
+template <PlaneTerm L, PlaneTerm R> PlaneRop2<ropDSx, PlaneExprOf<L>, PlaneExprOf<R>> operator^(const L &l, const R &r) {
+  return {planeExpr(l), planeExpr(r)};
+}
+
+template <PlaneTerm L, typename R> PlaneRop2<ropDSna, PlaneExprOf<L>, R> operator&(const L &l, const PlaneNot<R> &r) {
+  return {planeExpr(l), r.operand};
+}
+
+template <PlaneTerm L, typename R> PlaneRop2<ropDSno, PlaneExprOf<L>, R> operator|(const L &l, const PlaneNot<R> &r) {
+  return {planeExpr(l), r.operand};
+}
+
+template <PlaneTerm L, typename R> PlaneRop2<ropDSxn, PlaneExprOf<L>, R> operator^(const L &l, const PlaneNot<R> &r) {
+  return {planeExpr(l), r.operand};
+}
+
+//**********************************************************************
+//                                                      BitPlane::assign
+//**********************************************************************
+//
+//**    Synopsis
+//
+//      bool assign(x, y, cx, cy, expr)
+//
+//**    Description
+//
+//      Assign evaluates a plane expression over a destination rectangle.
+//      It clips much as bitBlt clips, except that the expression may
+//      have any number of operands.  Negative extents first normalise
+//      as they do for bitBlt.  Origins move together: if the
+//      destination origin or any operand origin is negative, all move
+//      right or down by the same amount.  The extent then shrinks to
+//      fit within the destination plane and within every operand.
+//
+//      The scan loop matches bitBlt's: masked stores at the left and
+//      right edges, unmasked stores in between.  Operands read their
+//      scan bytes before assignment stores the corresponding destination
+//      scan byte, so an operand may be the destination plane itself,
+//      provided its origin matches the destination origin.  With a clip
+//      mask attached, every store masks; see setClipMask.
+//
+//**********************************************************************
+
+template <typename Expr> bool BitPlane::assign(int x, int y, int cx, int cy, Expr expr) {
+  // Negative extents put the origins at the far edges, as for bitBlt.
+  if (cx < 0) {
+    cx = -cx;
+    x -= cx;
+    expr.offset(-cx, 0);
+  }
+  if (cy < 0) {
+    cy = -cy;
+    y -= cy;
+    expr.offset(0, -cy);
+  }
+  const int xOff = std::max({0, -x, -expr.getLeft()});
+  x += xOff;
+  cx -= xOff;
+  const int yOff = std::max({0, -y, -expr.getTop()});
+  y += yOff;
+  cy -= yOff;
+  expr.offset(xOff, yOff);
+  cx = std::min({cx, width - x, expr.getWidth()});
+  cy = std::min({cy, height - y, expr.getHeight()});
+  if (cx <= 0 || cy <= 0)
+    return false;
+  if (clipMask != nullptr && !clipExtent(x, y, cx, cy))
+    return false;
+
+  const int xMax = x + cx - 1;
+  const int extraScanByteCount = (xMax >> 3) - (x >> 3);
+  const scanbyte scanOrgMask = 0xffU >> (x & 7);
+  const scanbyte scanExtMask = 0xffU << (7 - (xMax & 7));
+  expr.bind(x);
+  for (int row = 0; row < cy; ++row) {
+    scanbyte *d = findBits(x, y + row);
+    expr.prefetch(row);
+    if (clipMask != nullptr) {
+      const scanbyte *c = clipMask->findBits(x, y + row);
+      for (int i = 0; i <= extraScanByteCount; ++i, ++d) {
+        scanbyte scanMask = *c++;
+        if (i == 0)
+          scanMask &= scanOrgMask;
+        if (i == extraScanByteCount)
+          scanMask &= scanExtMask;
+        *d = (*d & ~scanMask) | (scanMask & expr.fetch());
+      }
+      continue;
+    }
+    if (extraScanByteCount == 0) {
+      const scanbyte scanMask = scanOrgMask & scanExtMask;
+      *d = (*d & ~scanMask) | (scanMask & expr.fetch());
+      continue;
+    }
+    *d = (*d & ~scanOrgMask) | (scanOrgMask & expr.fetch());
+    ++d;
+    for (int scanByteCount = extraScanByteCount; --scanByteCount; ++d)
+      *d = expr.fetch();
+    *d = (*d & ~scanExtMask) | (scanExtMask & expr.fetch());
+  }
+  touch(x, y, cx, cy);
+  return true;
+}
+
+} // namespace raster
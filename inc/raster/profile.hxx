@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file profile.hxx
+/// \brief Row and column projection profiles of bit planes.
+/// \details Projection profiles count set pixels per scan line (the horizontal profile) and per pixel column (the
+///          vertical profile) within a rectangle; line and word segmentation look for their valleys.
+
+#pragma once
+
+#include "raster/bit_plane.hxx"
+
+#include <cstdint>
+#include <span>
+
+namespace raster {
+
+/// \brief Count set pixels per scan line within a rectangle.
+/// \details Counts[i] receives the count for scan line y + i. Scan lines outside the plane count zero.
+/// \param bitPlane Plane to project.
+/// \param x Left of the rectangle.
+/// \param y Top of the rectangle.
+/// \param cx Width of the rectangle.
+/// \param cy Height of the rectangle.
+/// \param counts At least cy counts.
+/// \return True if the rectangle intersects the plane, false otherwise.
+bool rowProfile(const BitPlane &bitPlane, int x, int y, int cx, int cy, std::span<std::uint32_t> counts);
+
+/// \brief Count set pixels per pixel column within a rectangle.
+/// \details Counts[i] receives the count for column x + i. Columns outside the plane count zero.
+/// \param bitPlane Plane to project.
+/// \param x Left of the rectangle.
+/// \param y Top of the rectangle.
+/// \param cx Width of the rectangle.
+/// \param cy Height of the rectangle.
+/// \param counts At least cx counts.
+/// \return True if the rectangle intersects the plane, false otherwise.
+bool columnProfile(const BitPlane &bitPlane, int x, int y, int cx, int cy, std::span<std::uint32_t> counts);
+
+} // namespace raster
@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file reduce.hxx
+/// \brief N-ary reductions across bit planes.
+/// \details Reductions combine many same-geometry bit planes into one in a single streaming pass: each scan word
+///          of every operand plane is read once and each destination scan word written once.
+
+#pragma once
+
+#include "raster/bit_plane.hxx"
+#include "raster/execution.hxx"
+
+#include <span>
+
+namespace raster {
+
+/// \brief Reduction across bit planes.
+enum Reduction {
+  reduceOr,       ///< Bit set if set in any plane.
+  reduceAnd,      ///< Bit set if set in every plane.
+  reduceXor,      ///< Bit set if set in an odd number of planes.
+  reduceAtLeast,  ///< Bit set if set in at least k planes.
+  reduceMajority, ///< Bit set if set in more than half the planes.
+};
+
+/// \brief Reduce bit planes into a destination bit plane.
+/// \details All planes, destination included, must have the same width and height. The destination may also
+///          appear as an operand. Destination bits beyond the plane's width remain unchanged.
+/// \param bitPlane Destination bit-plane.
+/// \param bitPlanes Operand bit-planes.
+/// \param reduction Reduction to apply.
+/// \param k Threshold for reduceAtLeast; ignored otherwise.
+/// \return True if successful, false if there are no operands or their geometry differs.
+bool reduce(BitPlane &bitPlane, std::span<const BitPlane *const> bitPlanes, Reduction reduction, int k = 0);
+
+/// \brief Reduce bit planes on the calling thread.
+bool reduce(const execution::sequenced_policy &policy, BitPlane &bitPlane, std::span<const BitPlane *const> bitPlanes,
+            Reduction reduction, int k = 0);
+
+/// \brief Reduce bit planes in parallel bands of scan lines.
+bool reduce(const execution::parallel_policy &policy, BitPlane &bitPlane, std::span<const BitPlane *const> bitPlanes,
+            Reduction reduction, int k = 0);
+
+} // namespace raster
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file region.hxx
+/// \brief Regions: sets of pixels as banded rectangles.
+/// \details A region describes an arbitrary set of pixels, e.g. the visible part of a window, as rectangles. Union,
+///          intersection and subtraction combine regions; bit-block transfers clip against them.
+
+#pragma once
+
+#include "raster/geometry.hxx"
+
+#include <span>
+#include <vector>
+
+namespace raster {
+
+// Region
+// ~~~~~~
+// Regions keep their rectangles in ``banded Y-X'' order.  Rectangles
+// group into horizontal bands; all rectangles in one band share the
+// same top and height.  Bands run top to bottom without overlapping;
+// rectangles within a band run left to right without overlapping or
+// touching.  Vertically adjacent bands with identical columns merge
+// into one.  Every region therefore has exactly one representation,
+// so equal regions compare equal rectangle by rectangle.
+//
+// Combining two regions sweeps down through the band edges of both.
+// Between successive edges, each region has a fixed list of column
+// spans; a merge of the two lists applies the operation, union,
+// intersection or subtraction, and yields the spans of the result.
+
+/// \class Region
+/// \brief Set of pixels as banded rectangles.
+class Region {
+public:
+  /// \brief Constructs an empty region.
+  Region() = default;
+
+  /// \brief Constructs a region from one rectangle.
+  /// \details Normalises negative extents; an empty rectangle gives an empty region.
+  explicit Region(Rect rect);
+
+  /// \brief Answer true if the region has no pixels.
+  bool empty() const { return rects.empty(); }
+
+  /// \brief Least rectangle containing the region.
+  Rect bounds() const;
+
+  /// \brief Rectangles in banded Y-X order.
+  std::span<const Rect> getRects() const { return rects; }
+
+  /// \brief Answer true if the region contains a pixel.
+  bool contains(int x, int y) const;
+
+  /// \brief Move the region.
+  void offset(int dx, int dy);
+
+  /// \brief Union: pixels in either region.
+  Region unite(const Region &other) const;
+
+  /// \brief Intersection: pixels in both regions.
+  Region intersect(const Region &other) const;
+
+  /// \brief Subtraction: pixels in this region but not the other.
+  Region subtract(const Region &other) const;
+
+  Region &operator|=(const Region &other) { return *this = unite(other); }
+  Region &operator&=(const Region &other) { return *this = intersect(other); }
+  Region &operator-=(const Region &other) { return *this = subtract(other); }
+
+  friend Region operator|(const Region &lhs, const Region &rhs) { return lhs.unite(rhs); }
+  friend Region operator&(const Region &lhs, const Region &rhs) { return lhs.intersect(rhs); }
+  friend Region operator-(const Region &lhs, const Region &rhs) { return lhs.subtract(rhs); }
+  friend bool operator==(const Region &, const Region &) = default;
+
+private:
+  template <typename Op> Region combine(const Region &other, Op op) const;
+
+  std::vector<Rect> rects;
+};
+
+} // namespace raster
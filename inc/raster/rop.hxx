@@ -55,3 +55,12 @@ enum Rop1 {
   dstInvert = ropDn,
   whiteness = rop1,
 };
+
+/// \brief Answer true if a binary raster operation depends on its source operand.
+/// \details Bit D+2S of the code gives the result; the source matters unless the S=0 and S=1 halves agree.
+constexpr bool ropUsesSource(Rop2 rop2) { return ((rop2 >> 2) & 3) != (rop2 & 3); }
+
+/// \brief Reduce a binary raster operation to a unary one for a uniform source.
+/// \details Answers rop0, ropD, ropDn or rop1: what the operation does to the destination where every source bit
+///          is s.
+constexpr Rop2 unaryRop(Rop2 rop2, int s) { return Rop2(((rop2 >> (2 * s)) & 3) * 5); }
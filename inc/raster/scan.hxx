@@ -21,6 +21,10 @@
 #pragma once
 
 #include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <bit>
 
 namespace raster {
 
@@ -28,4 +32,86 @@ namespace raster {
 /// \details This type is used to represent a single byte in the bit-plane.
 using scanbyte = uint8_t;
 
+/// \brief Scan word type.
+/// \details Whole-plane operations combine scan bytes eight at a time as scan words. Loads and stores copy bytes
+///          in memory order, so scan words suit bitwise logic, where the order of bits within a word does not
+///          matter.
+using scanword = uint64_t;
+
+/// \brief Load a scan word from any alignment.
+inline scanword loadScanWord(const scanbyte *p) {
+  scanword w;
+  (void)memcpy(&w, p, sizeof(w));
+  return w;
+}
+
+/// \brief Store a scan word at any alignment.
+inline void storeScanWord(scanbyte *p, scanword w) { (void)memcpy(p, &w, sizeof(w)); }
+
+/// \brief Reverse the byte order of a scan word.
+inline scanword byteSwap(scanword w) {
+#if defined(__GNUC__)
+  return __builtin_bswap64(w);
+#else
+  w = ((w & 0x00ff00ff00ff00ffU) << 8) | ((w >> 8) & 0x00ff00ff00ff00ffU);
+  w = ((w & 0x0000ffff0000ffffU) << 16) | ((w >> 16) & 0x0000ffff0000ffffU);
+  return (w << 32) | (w >> 32);
+#endif
+}
+
+/// \brief Load up to eight scan bytes as a scan word in scan order.
+/// \details The first scan byte lands in the most significant byte, so the most significant bit of the word is the
+///          leftmost pixel and shifting the word right moves pixels right. Missing scan bytes load as zeros.
+/// \param p Scan bytes.
+/// \param n Number of scan bytes to load, at most eight.
+inline scanword loadScanOrder(const scanbyte *p, size_t n = sizeof(scanword)) {
+  if (n == sizeof(scanword))
+    return std::endian::native == std::endian::little ? byteSwap(loadScanWord(p)) : loadScanWord(p);
+  scanword w = 0U;
+  for (size_t i = 0; i < sizeof(scanword); ++i)
+    w = (w << 8) | (i < n ? p[i] : 0U);
+  return w;
+}
+
+/// \brief Store a scan word in scan order as up to eight scan bytes.
+/// \param p Scan bytes.
+/// \param w Scan word in scan order.
+/// \param n Number of scan bytes to store, at most eight.
+inline void storeScanOrder(scanbyte *p, scanword w, size_t n = sizeof(scanword)) {
+  if (n == sizeof(scanword)) {
+    storeScanWord(p, std::endian::native == std::endian::little ? byteSwap(w) : w);
+    return;
+  }
+  for (size_t i = 0; i < n; ++i)
+    p[i] = static_cast<scanbyte>(w >> (56 - 8 * i));
+}
+
+/// \brief Load a scan word or scan byte.
+template <typename Word> inline Word loadScan(const scanbyte *p) {
+  if constexpr (sizeof(Word) == sizeof(scanbyte))
+    return *p;
+  else
+    return loadScanWord(p);
+}
+
+/// \brief Store a scan word or scan byte.
+template <typename Word> inline void storeScan(scanbyte *p, Word w) {
+  if constexpr (sizeof(Word) == sizeof(scanbyte))
+    *p = w;
+  else
+    storeScanWord(p, w);
+}
+
+/// \brief Visit a run of scan bytes eight at a time as scan words, then one at a time.
+/// \details Calls visit(offset, word) where the type of word, scanword or scanbyte, gives the unit at offset.
+/// \param scanByteCount Number of scan bytes in the run.
+/// \param visit Generic visitor taking an offset and a unit tag.
+template <typename Visitor> inline void forEachScan(size_t scanByteCount, Visitor &&visit) {
+  size_t offset = 0;
+  for (; offset + sizeof(scanword) <= scanByteCount; offset += sizeof(scanword))
+    visit(offset, scanword{});
+  for (; offset < scanByteCount; ++offset)
+    visit(offset, scanbyte{});
+}
+
 } // namespace raster
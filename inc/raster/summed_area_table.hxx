@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file summed_area_table.hxx
+/// \brief Summed-area tables over bit planes.
+/// \details This file contains the declaration of the SummedAreaTable class, an integral image of a bit plane
+///          answering set-pixel counts for any rectangle in constant time.
+
+#pragma once
+
+#include "raster/bit_plane.hxx"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace raster {
+
+// SummedAreaTable
+// ~~~~~~~~~~~~~~~
+// Entry (x, y) of a summed-area table holds the number of set pixels
+// above and to the left of pixel (x, y), i.e. within the rectangle from
+// the origin to x by y exclusive.  There are width+1 by height+1 entries.
+// Any rectangle's count is then four entries combined by inclusion-
+// exclusion, regardless of the rectangle's size.  The price is memory:
+// entries are 32 bits, so the table takes 32 times the plane's size.
+//
+// Entries live in tiles of 8 by 8, each tile contiguous.  The four
+// corners of a small rectangle often share a tile, or sit in vertically
+// adjacent tiles only a short stride apart, rather than whole table
+// rows apart.
+//
+// Building walks the plane a scan word at a time.  Words without set
+// pixels carry the row's running count straight across their 64
+// entries without looking at individual bits; other words give each
+// entry a population count of their leading bits.  After a blit
+// dirties a rectangle, update() rebuilds only the entries that can
+// change: those right of and below the rectangle's top-left corner.
+
+/// \class SummedAreaTable
+/// \brief Integral image of a bit plane.
+class SummedAreaTable {
+public:
+  /// \brief Default constructor.
+  /// \details Constructs an empty table; counts answer zero.
+  SummedAreaTable() = default;
+
+  /// \brief Build the table for a bit plane.
+  /// \return True if successful, false if the plane is empty.
+  bool create(const BitPlane &bitPlane);
+
+  /// \brief Rebuild after a rectangle of the plane changed.
+  /// \param bitPlane Plane the table was built for, with the same width and height.
+  /// \param x Left of the changed rectangle.
+  /// \param y Top of the changed rectangle.
+  /// \param cx Width of the changed rectangle.
+  /// \param cy Height of the changed rectangle.
+  /// \return True if successful, false if geometry differs or the rectangle misses the plane.
+  bool update(const BitPlane &bitPlane, int x, int y, int cx, int cy);
+
+  /// \brief Count set pixels in a rectangle.
+  /// \details Clips the rectangle against the plane's borders.
+  /// \return Number of set pixels.
+  std::uint32_t count(int x, int y, int cx, int cy) const;
+
+  int getWidth() const { return width; }
+  int getHeight() const { return height; }
+
+private:
+  static constexpr int tileShift = 3;
+  static constexpr int tileMask = (1 << tileShift) - 1;
+
+  std::size_t index(int x, int y) const {
+    const std::size_t tile = static_cast<std::size_t>(y >> tileShift) * tilesAcross + (x >> tileShift);
+    return (tile << (2 * tileShift)) + ((y & tileMask) << tileShift) + (x & tileMask);
+  }
+  std::uint32_t at(int x, int y) const { return table[index(x, y)]; }
+  void build(const BitPlane &bitPlane, int x, int y);
+
+  int width = 0;
+  int height = 0;
+  std::size_t tilesAcross = 0;
+  std::vector<std::uint32_t> table;
+};
+
+} // namespace raster
@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file tile_grid.hxx
+/// \brief Tile geometry for tiled planes.
+/// \details Tiled planes divide their pixels into square tiles, each a bit plane of its own. The grid clips
+///          rectangles to the plane and visits the tiles that a rectangle covers.
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+
+namespace raster {
+
+/// \brief Default tile size in pixels; 256 by 256 pixels make an 8 KiB tile.
+inline constexpr int defaultTileSize = 256;
+
+/// \class TileGrid
+/// \brief Geometry of a plane divided into square tiles.
+/// \details Tiles run left to right then top to bottom. Tiles on the right and bottom edges may extend beyond the
+///          plane; operations clip to the plane first so that tile pixels beyond it stay zero.
+struct TileGrid {
+  int width = 0;
+  int height = 0;
+  int tileSize = defaultTileSize;
+  int columns = 0;
+  int rows = 0;
+
+  /// \brief Size the grid.
+  /// \param tileSize Tile size in pixels; rounds up to a multiple of eight.
+  /// \return True if the plane is not empty, false otherwise or if the tile bytes or tile count overflow an int.
+  bool create(int cx, int cy, int tileSize) {
+    constexpr long long intMax = std::numeric_limits<int>::max();
+    if (cx <= 0 || cy <= 0 || tileSize <= 0 || tileSize > intMax - 7)
+      return false;
+    const long long size = (tileSize + 7LL) & ~7LL;
+    const long long columnCount = (cx + size - 1) / size;
+    const long long rowCount = (cy + size - 1) / size;
+    if ((size >> 3) * size + 8 > intMax || columnCount * rowCount > intMax)
+      return false;
+    width = cx;
+    height = cy;
+    this->tileSize = static_cast<int>(size);
+    columns = static_cast<int>(columnCount);
+    rows = static_cast<int>(rowCount);
+    return true;
+  }
+
+  int tileCount() const { return columns * rows; }
+
+  /// \brief Scan bytes per tile.
+  int tileScanBytes() const { return (tileSize >> 3) * tileSize; }
+
+  /// \brief Bytes of storage per tile.
+  /// \details Adds one spare word after the last scan line: phase-aligned fetches may read one scan byte beyond
+  ///          the last byte of a source rectangle, and a tile ends exactly where its last scan line ends.
+  int tileStoreBytes() const { return tileScanBytes() + 8; }
+
+  /// \brief Clip a destination rectangle to the plane, moving a source origin with it.
+  /// \details Normalises negative extents first, as BitPlane::bitBlt() does: the origins then name the far edge.
+  /// \return True if anything remains, false otherwise.
+  bool clip(int &x, int &y, int &cx, int &cy, int &xSrc, int &ySrc) const {
+    if (cx < 0) {
+      cx = -cx;
+      x -= cx;
+      xSrc -= cx;
+    }
+    if (cy < 0) {
+      cy = -cy;
+      y -= cy;
+      ySrc -= cy;
+    }
+    if (x < 0) {
+      cx += x;
+      xSrc -= x;
+      x = 0;
+    }
+    if (y < 0) {
+      cy += y;
+      ySrc -= y;
+      y = 0;
+    }
+    cx = std::min(cx, width - x);
+    cy = std::min(cy, height - y);
+    return cx > 0 && cy > 0;
+  }
+
+  /// \brief Visit the tiles covered by a rectangle already clipped to the plane.
+  /// \param visit Called as visit(index, xTile, yTile, x, y, cx, cy) with the tile's index and origin, and the
+  ///        part of the rectangle within the tile in plane co-ordinates.
+  template <typename Visit> void forEachTile(int x, int y, int cx, int cy, Visit &&visit) const {
+    for (int row = y / tileSize; row * tileSize < y + cy; ++row) {
+      const int yTile = row * tileSize;
+      const int y0 = std::max(y, yTile);
+      const int y1 = std::min(y + cy, yTile + tileSize);
+      for (int column = x / tileSize; column * tileSize < x + cx; ++column) {
+        const int xTile = column * tileSize;
+        const int x0 = std::max(x, xTile);
+        const int x1 = std::min(x + cx, xTile + tileSize);
+        visit(row * columns + column, xTile, yTile, x0, y0, x1 - x0, y1 - y0);
+      }
+    }
+  }
+};
+
+} // namespace raster
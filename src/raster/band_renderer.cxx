@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file band_renderer.cxx
+/// \brief Banded rendering of display lists.
+/// \details This file contains display-list recording and the band-by-band playback behind BandRenderer.
+
+#include "raster/band_renderer.hxx"
+
+#include <algorithm> // for std::min(), std::max(), std::fill_n()
+#include <utility>   // for std::move()
+
+namespace raster {
+
+namespace {
+
+// Blits normalise negative extents; so must their page scan lines.
+int topOf(int y, int cy) { return cy < 0 ? y + cy : y; }
+int bottomOf(int y, int cy) { return cy < 0 ? y : y + cy; }
+
+} // namespace
+
+void DisplayList::add(int top, int bottom, Draw draw) {
+  if (top < bottom)
+    items.push_back({top, bottom, std::move(draw)});
+}
+
+void DisplayList::bitBlt(int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc, int xSrc, int ySrc, Rop2 rop2) {
+  add(topOf(y, cy), bottomOf(y, cy), [=, &bitPlaneSrc](BitPlane &band, int yBand) {
+    return band.bitBlt(x, y - yBand, cx, cy, bitPlaneSrc, xSrc, ySrc, rop2);
+  });
+}
+
+void DisplayList::bitBlt(int x, int y, int cx, int cy, Rop1 rop1) {
+  add(topOf(y, cy), bottomOf(y, cy),
+      [=](BitPlane &band, int yBand) { return band.bitBlt(x, y - yBand, cx, cy, rop1); });
+}
+
+void DisplayList::drawLine(int x0, int y0, int x1, int y1, Rop2 rop2) {
+  add(std::min(y0, y1), std::max(y0, y1) + 1, [=](BitPlane &band, int yBand) {
+    return raster::drawLine(band, x0, y0 - yBand, x1, y1 - yBand, rop2);
+  });
+}
+
+void DisplayList::drawRect(int x, int y, int cx, int cy, Rop2 rop2) {
+  add(y, y + cy, [=](BitPlane &band, int yBand) { return raster::drawRect(band, x, y - yBand, cx, cy, rop2); });
+}
+
+void DisplayList::fillRect(int x, int y, int cx, int cy, Rop2 rop2) {
+  add(y, y + cy, [=](BitPlane &band, int yBand) { return raster::fillRect(band, x, y - yBand, cx, cy, rop2); });
+}
+
+void DisplayList::drawEllipse(int x, int y, int rx, int ry, Rop2 rop2) {
+  add(y - ry, y + ry + 1,
+      [=](BitPlane &band, int yBand) { return raster::drawEllipse(band, x, y - yBand, rx, ry, rop2); });
+}
+
+void DisplayList::fillEllipse(int x, int y, int rx, int ry, Rop2 rop2) {
+  add(y - ry, y + ry + 1,
+      [=](BitPlane &band, int yBand) { return raster::fillEllipse(band, x, y - yBand, rx, ry, rop2); });
+}
+
+void DisplayList::strokeEllipse(int x, int y, int rx, int ry, int width, Rop2 rop2) {
+  add(y - ry - width, y + ry + width + 1,
+      [=](BitPlane &band, int yBand) { return raster::strokeEllipse(band, x, y - yBand, rx, ry, width, rop2); });
+}
+
+void DisplayList::drawArc(int x, int y, int rx, int ry, double startAngle, double sweepAngle, Rop2 rop2) {
+  add(y - ry, y + ry + 1, [=](BitPlane &band, int yBand) {
+    return raster::drawArc(band, x, y - yBand, rx, ry, startAngle, sweepAngle, rop2);
+  });
+}
+
+void DisplayList::strokeLine(int x0, int y0, int x1, int y1, int width, LineCap lineCap, Rop2 rop2) {
+  add(std::min(y0, y1) - width, std::max(y0, y1) + width + 1, [=](BitPlane &band, int yBand) {
+    return raster::strokeLine(band, x0, y0 - yBand, x1, y1 - yBand, width, lineCap, rop2);
+  });
+}
+
+void DisplayList::fillPath(const Path &path, FillRule fillRule, Rop2 rop2) {
+  const Rect bounds = path.bounds();
+  add(bounds.y, bounds.y + bounds.cy + 1,
+      [=](BitPlane &band, int yBand) { return raster::fillPath(band, path, fillRule, rop2, yBand); });
+}
+
+BandSink fileSink(std::FILE *file) {
+  return [file](const BitPlane &band, int yBand) {
+    (void)yBand;
+    const std::size_t scanBytes = (band.getWidth() + 7) >> 3;
+    for (int y = 0; y < band.getHeight(); ++y)
+      if (std::fwrite(band.bits(0, y), 1, scanBytes, file) != scanBytes)
+        return false;
+    return true;
+  };
+}
+
+BandRenderer::BandRenderer(int cx, int cy, int cyBand) : width(cx), height(cy), cyBand(cyBand) {
+  if (cx <= 0 || cy <= 0) {
+    this->cyBand = 0;
+    return;
+  }
+  if (cyBand <= 0)
+    this->cyBand = static_cast<int>(std::max<std::size_t>(defaultBandScanBytes / ((cx + 7) >> 3), 1U));
+  this->cyBand = std::min(this->cyBand, cy);
+  if (!band.create(cx, this->cyBand))
+    return;
+  // Clear the padding bits once; no operation ever writes them.
+  for (int y = 0; y < this->cyBand; ++y)
+    std::fill_n(band.bits(0, y), (cx + 7) >> 3, scanbyte(0U));
+}
+
+//**********************************************************************
+//                                                  BandRenderer::render
+//**********************************************************************
+//
+//**    Synopsis
+//
+//      bool render(displayList, sink, background)
+//
+//**    Description
+//
+//      Bucketing costs one pass over the display list per page and one
+//      index per band an operation touches; each band then plays back
+//      only the operations reaching it.  Operations lying wholly off
+//      the page drop out.  The last band may be short, in which case it
+//      renders into and streams a view of the band plane's top.
+//
+//**********************************************************************
+
+bool BandRenderer::render(const DisplayList &displayList, const BandSink &sink, Rop1 background) {
+  if (cyBand <= 0 || band.getWidth() == 0)
+    return false;
+  const int bandCount = (height + cyBand - 1) / cyBand;
+  std::vector<std::vector<std::size_t>> buckets(bandCount);
+  for (std::size_t i = 0; i < displayList.items.size(); ++i) {
+    const DisplayList::Item &item = displayList.items[i];
+    if (item.bottom <= 0 || item.top >= height)
+      continue;
+    const int first = std::max(item.top, 0) / cyBand;
+    const int last = std::min(item.bottom - 1, height - 1) / cyBand;
+    for (int bucket = first; bucket <= last; ++bucket)
+      buckets[bucket].push_back(i);
+  }
+  for (int bucket = 0; bucket < bandCount; ++bucket) {
+    const int yBand = bucket * cyBand;
+    const int cy = std::min(cyBand, height - yBand);
+    BitPlane view;
+    BitPlane &target = cy == cyBand ? band : (view = band.view(0, 0, width, cy));
+    target.bitBlt(0, 0, width, cy, background);
+    for (const std::size_t i : buckets[bucket])
+      displayList.items[i].draw(target, yBand);
+    if (!sink(target, yBand))
+      return false;
+  }
+  return true;
+}
+
+} // namespace raster
@@ -23,12 +23,100 @@
 
 #include "raster/bit_plane.hxx"
 #include "raster/blt.hxx"
+#include "raster/diff.hxx"
+#include "raster/execution.hxx"
+#include "raster/region.hxx"
 
-#include <cassert> // for assert()
-#include <cstring> // for memcpy()
+#include <algorithm> // for std::clamp(), std::fill(), std::min(), std::max(), std::rotate()
+#include <atomic>    // for std::atomic_ref
+#include <bit>       // for std::countr_zero()
+#include <cassert>   // for assert()
+#include <cstdlib>   // for std::abs()
+#include <cstring>   // for memcpy()
+#include <numeric>   // for std::iota()
+#include <utility>   // for std::swap()
 
 namespace raster {
 
+namespace {
+
+// PhaseSelect
+// ~~~~~~~~~~~
+// Holds the three PhaseAlign functors and decides between them, based
+// on how the bits are out of phase.  The destination alignment is x & 7,
+// i.e. how many bits from the left side of the scan byte.  Expression
+// xSrc & 7 gives the source alignment.  The sign and magnitude of the
+// difference between the alignments determines the direction and
+// amount of shift.
+
+struct PhaseSelect {
+  PhaseAlign *select(int x, int xSrc) {
+    int shiftCount = (x & 7) - (xSrc & 7);
+    if (shiftCount < 0) {
+      fetchLeftShift.shiftCount = -shiftCount;
+      return &fetchLeftShift;
+    }
+    if (shiftCount == 0)
+      return &fetch;
+    fetchRightShift.shiftCount = shiftCount;
+    return &fetchRightShift;
+  }
+  PhaseAlign fetch;
+  RightShift fetchRightShift;
+  LeftShift fetchLeftShift;
+};
+
+// loadBits(scan, pos, lo, hi) and storeBits(scan, pos, w, lo, hi, clip)
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~     ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Horizontal shifts move 64 bits at a time between any bit positions
+// of a scan line, as scan words in scan order.  Only positions within
+// the run [lo, hi) take part: loads read zeros outside the run, stores
+// leave bits outside it alone.  When all 64 bits lie within the run,
+// a load funnels two scan-ordered words into one with a pair of shifts
+// and a store writes eight whole scan bytes.  Otherwise the bits go a
+// scan byte at a time, masking where the run begins or ends, and where
+// the clip mask's scan line, if any, is clear.
+
+scanword loadBits(const scanbyte *scan, int pos, int lo, int hi) {
+  if (lo <= pos && pos + 64 <= hi) {
+    const scanbyte *p = scan + (pos >> 3);
+    const int shift = pos & 7;
+    const scanword w = loadScanOrder(p);
+    return shift == 0 ? w : (w << shift) | (p[8] >> (8 - shift));
+  }
+  const int a = std::max(pos, lo);
+  const int b = std::min(pos + 64, hi);
+  scanword w = 0U;
+  for (int p = a; p < b;) {
+    const int k = std::min(8 - (p & 7), b - p);
+    const scanword bits = (scan[p >> 3] >> (8 - (p & 7) - k)) & ((1U << k) - 1U);
+    w |= bits << (64 - (p - pos) - k);
+    p += k;
+  }
+  return w;
+}
+
+void storeBits(scanbyte *scan, int pos, scanword w, int lo, int hi, const scanbyte *clip) {
+  if (clip == nullptr && (pos & 7) == 0 && lo <= pos && pos + 64 <= hi) {
+    storeScanOrder(scan + (pos >> 3), w);
+    return;
+  }
+  const int a = std::max(pos, lo);
+  const int b = std::min(pos + 64, hi);
+  for (int p = a; p < b;) {
+    const int k = std::min(8 - (p & 7), b - p);
+    const int shift = 8 - (p & 7) - k;
+    scanbyte mask = static_cast<scanbyte>(((1U << k) - 1U) << shift);
+    if (clip != nullptr)
+      mask &= clip[p >> 3];
+    const auto bits = static_cast<scanbyte>(((w >> (64 - (p - pos) - k)) & ((1U << k) - 1U)) << shift);
+    scan[p >> 3] = (scan[p >> 3] & ~mask) | (bits & mask);
+    p += k;
+  }
+}
+
+} // namespace
+
 //**    Name
 //
 //      BitPlane --- rectangular arrays of bits
@@ -43,9 +131,23 @@ namespace raster {
 //
 //              BitPlane()              constructs dynamic bit-planes
 //              BitPlane(cx, cy, v)     constructs static bit-planes
+//              BitPlane(cx, cy, v, n)  constructs static bit-planes with stride
 //              create(cx,cy)           allocates free store
 //              bitBlt(..., rop2)       blits two bit-plane operands
 //              bitBlt(..., rop1)       blits one bit-plane operand
+//              bitBlt(policy, ...)     blits in bands, maybe in parallel
+//              bitBltAtomic(...)       blits with atomic edge stores
+//              bitBlt(region, ...)     blits clipped against a region
+//              setClipMask(clipMask)   clips drawing to a mask plane
+//              detectUniformSources(b) fills where source lines are uniform
+//              operator=(expr)         evaluates a plane expression
+//              view(x, y, cx, cy)      makes a zero-copy view
+//              trackDamage(grain)      starts tracking damage
+//              takeDamage()            takes damage as rectangles
+//              trackOccupancy()        summarises occupied scan words
+//              indexRows()             indexes scan lines through a row table
+//              scrollRows(dy)          scrolls by moving row pointers
+//              shiftBits(..., dx)      shifts or rotates pixels in place
 //              ~BitPlane()             de-allocates free store
 //              getWidth()              gets the width
 //              getHeight()             gets the height
@@ -113,6 +215,14 @@ BitPlane::BitPlane(int cx, int cy, scanbyte v[]) {
   autoDelete = false;
 }
 
+// The stride, widthScanBytes, may exceed the scan bytes needed for the
+// width: the bit plane is then a window onto a wider one.  A stride
+// too small for the width is ignored.
+BitPlane::BitPlane(int cx, int cy, scanbyte v[], int widthScanBytes) : BitPlane(cx, cy, v) {
+  if (width > 0 && widthScanBytes > this->widthScanBytes)
+    this->widthScanBytes = widthScanBytes;
+}
+
 // Don't bit-wise copy a BitPlane!
 BitPlane::BitPlane(const BitPlane &copy) {
   scanbyte *v;
@@ -128,6 +238,112 @@ BitPlane::BitPlane(const BitPlane &copy) {
   widthScanBytes = copy.widthScanBytes;
   store = v;
   autoDelete = copy.autoDelete;
+  trackingDamage = copy.trackingDamage;
+  damageGrain = copy.damageGrain;
+  damageColumns = copy.damageColumns;
+  damage = copy.damage;
+  clipMask = copy.clipMask;
+  detectingUniform = copy.detectingUniform;
+  // A static copy shares scan bytes that either plane may write without
+  // the other knowing; only a deep copy can trust the summary.
+  if (copy.autoDelete) {
+    trackingOccupancy = copy.trackingOccupancy;
+    occupancyStride = copy.occupancyStride;
+    occupancy = copy.occupancy;
+    occupiedRows = copy.occupiedRows;
+  }
+  // Row pointers of a deep copy point into the copy's scan bytes, in the
+  // same places relative to the start.
+  rowPointers = copy.rowPointers;
+  if (copy.autoDelete)
+    for (scanbyte *&row : rowPointers)
+      row = v + (row - copy.store);
+  rowOrigin = copy.rowOrigin;
+  if (copy.rowTable != nullptr)
+    rowTable = rowPointers.data() + rowOrigin;
+}
+
+BitPlane::BitPlane(BitPlane &&move) noexcept { swap(move); }
+
+BitPlane &BitPlane::operator=(const BitPlane &copy) {
+  if (this != &copy) {
+    BitPlane temp(copy);
+    swap(temp);
+  }
+  return *this;
+}
+
+BitPlane &BitPlane::operator=(BitPlane &&move) noexcept {
+  BitPlane temp(static_cast<BitPlane &&>(move));
+  swap(temp);
+  return *this;
+}
+
+void BitPlane::swap(BitPlane &other) noexcept {
+  std::swap(width, other.width);
+  std::swap(height, other.height);
+  std::swap(widthScanBytes, other.widthScanBytes);
+  std::swap(store, other.store);
+  std::swap(autoDelete, other.autoDelete);
+  std::swap(trackingDamage, other.trackingDamage);
+  std::swap(damageGrain, other.damageGrain);
+  std::swap(damageColumns, other.damageColumns);
+  damage.swap(other.damage);
+  std::swap(clipMask, other.clipMask);
+  std::swap(detectingUniform, other.detectingUniform);
+  std::swap(trackingOccupancy, other.trackingOccupancy);
+  std::swap(occupancyStride, other.occupancyStride);
+  occupancy.swap(other.occupancy);
+  occupiedRows.swap(other.occupiedRows);
+  rowPointers.swap(other.rowPointers);
+  std::swap(rowOrigin, other.rowOrigin);
+  std::swap(rowTable, other.rowTable);
+}
+
+//**********************************************************************
+//                                                        BitPlane::view
+//**********************************************************************
+//
+//**    Synopsis
+//
+//      BitPlane view(x, y, cx, cy)
+//
+//**    Description
+//
+//      View answers a static bit plane sharing ``this'' plane's scan
+//      bytes: writing to the view writes to this plane.  The view clips
+//      to this plane.  Bit planes begin on scan byte boundaries, so the
+//      view's left edge rounds down to a multiple of eight; the view
+//      widens by the difference, x & 7, and pixel (x, y) of this plane
+//      becomes pixel (x & 7, 0) of the view.  The view remains valid
+//      while this plane's scan bytes do.  Views of an indexed plane take
+//      their own row table, a copy of the rows they cover.
+//
+//      Writes through the view bypass this plane's occupancy summary,
+//      which would then wrongly show written scan words as empty to
+//      blits, bounds, pixel extraction and frame differences.  Taking a
+//      view therefore stops tracking occupancy here; tracking again once
+//      done with the view rebuilds the summary.
+//
+//**********************************************************************
+
+BitPlane BitPlane::view(int x, int y, int cx, int cy) {
+  const int x0 = (x < 0 ? 0 : x) & ~7;
+  const int y0 = y < 0 ? 0 : y;
+  const int x1 = x + cx < width ? x + cx : width;
+  const int y1 = y + cy < height ? y + cy : height;
+  if (x1 <= x0 || y1 <= y0)
+    return BitPlane();
+  untrackOccupancy();
+  BitPlane view(x1 - x0, y1 - y0, findBits(x0, y0), widthScanBytes);
+  if (rowTable != nullptr) {
+    view.rowPointers.resize(2U * static_cast<std::size_t>(y1 - y0));
+    view.rowTable = view.rowPointers.data();
+    for (int row = 0; row < y1 - y0; ++row)
+      view.rowTable[row] = findBits(x0, y0 + row);
+    view.mirrorRows(0, y1 - y0);
+  }
+  return view;
 }
 
 //**********************************************************************
@@ -161,8 +377,16 @@ bool BitPlane::create(int cx, int cy) {
 
   // How to create a new bit plane: first, dispose of the old one; next,
   // compute the scan line size in double-words; finally, allocate free-
-  // storage for the bits.
-  this->~BitPlane();
+  // storage for the bits.  The old row table points into the old scan
+  // bytes, so it goes first; the new plane indexes afresh.
+  const bool indexed = rowTable != nullptr;
+  rowPointers.clear();
+  rowOrigin = 0;
+  rowTable = nullptr;
+  if (autoDelete)
+    delete[] store;
+  store = nullptr;
+  autoDelete = false;
   widthScanBytes = cx >> 3;
   if (cx & 7)
     ++widthScanBytes;
@@ -172,21 +396,530 @@ bool BitPlane::create(int cx, int cy) {
   autoDelete = true;
   width = cx;
   height = cy;
+  if (indexed)
+    indexRows();
+  if (trackingDamage)
+    resizeDamage(1U);
+  if (trackingOccupancy)
+    trackOccupancy();
   return true;
 }
 
-// BitPlane::findBits(x,y)
-// ~~~~~~~~~~~~~~~~~~~~~~~
-// Given the co-ordinate of a bit, findBits returns the address of its
-// scan byte.  The calculation assumes one bit per pixel and scan byte-aligned
-// scan lines --- BitPlane class constraints.  Expression x & 7 gives
-// the bit's position within the scan byte; where 0 corresponds to the most
-// significant bit, 7 to bit zero.  The x and y co-ordinates aren't
-// clipped.  FindBits is a protected helper.
+//**********************************************************************
+//                                                 BitPlane::trackDamage
+//**********************************************************************
+//
+//**    Synopsis
+//
+//      void trackDamage(grain)
+//      std::vector<Rect> takeDamage()
+//      void clearDamage()
+//      void touch(x, y, cx, cy)
+//
+//**    Description
+//
+//      A plane tracking damage keeps a grid of cells, one byte per
+//      cell, each cell covering grain.cx columns by grain.cy scan lines.
+//      Writes mark cells after clipping, so marking costs in proportion
+//      to the cells a write covers, not the pixels.  Taking the damage
+//      coalesces the marked cells into rectangles, exactly as frameDiff
+//      does for a comparison; a presenter then flushes only those rect-
+//      angles, without comparing frames.  Concurrent writers, parallel
+//      bands or atomic blits, mark cells with relaxed atomic stores; all
+//      store the same value so order does not matter.
+//
+//**********************************************************************
+
+void BitPlane::trackDamage(Grain grain) {
+  if (grain.cx <= 0)
+    grain.cx = Grain{}.cx;
+  if (grain.cy <= 0)
+    grain.cy = Grain{}.cy;
+  trackingDamage = true;
+  damageGrain = grain;
+  resizeDamage(0U);
+}
 
-inline scanbyte *BitPlane::findBits(int x, int y) const { return store + widthScanBytes * y + (x >> 3); }
+void BitPlane::untrackDamage() {
+  trackingDamage = false;
+  damageColumns = 0;
+  damage.clear();
+}
 
-inline const scanbyte *BitPlane::bits(int x, int y) const { return findBits(x, y); }
+std::vector<Rect> BitPlane::takeDamage() {
+  std::vector<Rect> rects;
+  coalesce(damage, damageColumns, width, height, damageGrain, rects);
+  clearDamage();
+  return rects;
+}
+
+void BitPlane::clearDamage() { std::fill(damage.begin(), damage.end(), std::uint8_t(0U)); }
+
+void BitPlane::resizeDamage(std::uint8_t cell) {
+  damageColumns = (width + damageGrain.cx - 1) / damageGrain.cx;
+  const int rows = (height + damageGrain.cy - 1) / damageGrain.cy;
+  damage.assign(static_cast<std::size_t>(damageColumns) * rows, cell);
+}
+
+void BitPlane::recordDamage(int x, int y, int cx, int cy) {
+  const int xMax = std::min(x + cx, width);
+  const int yMax = std::min(y + cy, height);
+  x = std::max(x, 0);
+  y = std::max(y, 0);
+  if (xMax <= x || yMax <= y)
+    return;
+  const int column0 = x / damageGrain.cx;
+  const int column1 = (xMax - 1) / damageGrain.cx;
+  for (int row = y / damageGrain.cy; row <= (yMax - 1) / damageGrain.cy; ++row) {
+    std::uint8_t *cell = damage.data() + static_cast<std::ptrdiff_t>(row) * damageColumns;
+    for (int column = column0; column <= column1; ++column)
+      std::atomic_ref<std::uint8_t>(cell[column]).store(1U, std::memory_order_relaxed);
+  }
+}
+
+//**********************************************************************
+//                                              BitPlane::trackOccupancy
+//**********************************************************************
+//
+//**    Synopsis
+//
+//      void trackOccupancy()
+//      bool isRowOccupied(y)
+//      bool isWordOccupied(y, offset)
+//      int nextOccupiedRow(y)
+//
+//**    Description
+//
+//      Sparse planes, mostly zero, waste time in every scan.  The occu-
+//      pancy summary has two levels.  The first has one bit for every
+//      scan word of every scan line, where scan words start every eight
+//      scan bytes from the start of the line, just as the queries load
+//      them.  The second level has one bit for every scan line, set if
+//      any of the line's first-level bits is set.  Queries test the
+//      second level 64 scan lines at a time, then the first level, and
+//      only then load scan bytes.  Bits beyond the width never count.
+//
+//      Touching a rectangle after writing it settles the summary: it
+//      reloads the scan words that the rectangle covers and sets or
+//      clears their bits exactly.  Settling costs one load per scan
+//      word, a small fraction of the write.  Scan lines belong to one
+//      band at a time, so parallel bands settle their own first-level
+//      bits without synchronisation; second-level words span 64 scan
+//      lines, so those update atomically.  Atomic blits write edge scan
+//      bytes concurrently, so they cannot reload them; instead they mark
+//      the covered words occupied before writing.  A marked word that
+//      turns out to be empty costs a query one wasted load; settling it
+//      later, or tracking afresh, clears it.
+//
+//**********************************************************************
+
+void BitPlane::trackOccupancy() {
+  const std::size_t scanByteCount = (static_cast<std::size_t>(width) + 7U) >> 3;
+  const std::size_t wordCount = (scanByteCount + 7U) >> 3;
+  trackingOccupancy = true;
+  occupancyStride = (wordCount + 63U) >> 6;
+  occupancy.assign(occupancyStride * height, 0U);
+  occupiedRows.assign((static_cast<std::size_t>(height) + 63U) >> 6, 0U);
+  settleOccupancy(0, 0, width, height);
+}
+
+void BitPlane::untrackOccupancy() {
+  trackingOccupancy = false;
+  occupancyStride = 0;
+  occupancy.clear();
+  occupiedRows.clear();
+}
+
+int BitPlane::nextOccupiedRow(int y) const {
+  if (y < 0)
+    y = 0;
+  if (y >= height)
+    return height;
+  if (!trackingOccupancy)
+    return y;
+  std::size_t i = static_cast<std::size_t>(y) >> 6;
+  std::uint64_t rows = occupiedRows[i] & (~std::uint64_t(0U) << (y & 63));
+  while (rows == 0U) {
+    if (++i == occupiedRows.size())
+      return height;
+    rows = occupiedRows[i];
+  }
+  return std::min(static_cast<int>(i << 6) + std::countr_zero(rows), height);
+}
+
+void BitPlane::settleOccupancy(int x, int y, int cx, int cy) {
+  const int xMax = std::min(x + cx, width);
+  const int yMax = std::min(y + cy, height);
+  x = std::max(x, 0);
+  y = std::max(y, 0);
+  if (xMax <= x || yMax <= y)
+    return;
+  const std::size_t scanByteCount = (static_cast<std::size_t>(width) + 7U) >> 3;
+  const std::size_t word0 = static_cast<std::size_t>(x) >> 6;
+  const std::size_t word1 = static_cast<std::size_t>(xMax - 1) >> 6;
+  for (int row = y; row < yMax; ++row) {
+    const scanbyte *scan = findBits(0, row);
+    std::uint64_t *words = occupancy.data() + occupancyStride * row;
+    for (std::size_t word = word0; word <= word1; ++word) {
+      const std::size_t offset = word << 3;
+      scanword w = loadScanOrder(scan + offset, std::min(scanByteCount - offset, sizeof(scanword)));
+      const int xWord = static_cast<int>(offset * 8U);
+      if (width - xWord < 64)
+        w &= ~(~scanword(0U) >> (width - xWord));
+      const std::uint64_t bit = std::uint64_t(1U) << (word & 63U);
+      if (w != 0U)
+        words[word >> 6] |= bit;
+      else
+        words[word >> 6] &= ~bit;
+    }
+    bool any = false;
+    for (std::size_t i = 0; i < occupancyStride && !any; ++i)
+      any = words[i] != 0U;
+    std::atomic_ref<std::uint64_t> rows(occupiedRows[static_cast<std::size_t>(row) >> 6]);
+    const std::uint64_t bit = std::uint64_t(1U) << (row & 63);
+    if (any)
+      rows.fetch_or(bit, std::memory_order_relaxed);
+    else
+      rows.fetch_and(~bit, std::memory_order_relaxed);
+  }
+}
+
+void BitPlane::mark(int x, int y, int cx, int cy) {
+  if (trackingDamage)
+    recordDamage(x, y, cx, cy);
+  if (!trackingOccupancy)
+    return;
+  const int xMax = std::min(x + cx, width);
+  const int yMax = std::min(y + cy, height);
+  x = std::max(x, 0);
+  y = std::max(y, 0);
+  if (xMax <= x || yMax <= y)
+    return;
+  const std::size_t word0 = static_cast<std::size_t>(x) >> 6;
+  const std::size_t word1 = static_cast<std::size_t>(xMax - 1) >> 6;
+  for (int row = y; row < yMax; ++row) {
+    std::uint64_t *words = occupancy.data() + occupancyStride * row;
+    for (std::size_t word = word0; word <= word1; ++word)
+      std::atomic_ref<std::uint64_t>(words[word >> 6]).fetch_or(std::uint64_t(1U) << (word & 63U),
+                                                                  std::memory_order_relaxed);
+    std::atomic_ref<std::uint64_t>(occupiedRows[static_cast<std::size_t>(row) >> 6])
+        .fetch_or(std::uint64_t(1U) << (row & 63), std::memory_order_relaxed);
+  }
+}
+
+//**********************************************************************
+//                                                   BitPlane::indexRows
+//**********************************************************************
+//
+//**    Synopsis
+//
+//      bool indexRows()
+//      bool unindexRows()
+//      bool scrollRows(dy)
+//      bool insertRows(y, cy)
+//      bool deleteRows(y, cy)
+//      bool swapRows(y0, y1)
+//      bool flipRows()
+//
+//**    Description
+//
+//      An indexed plane finds scan line y at rowTable[y] rather than at
+//      store + widthScanBytes * y.  Terminal-like planes scroll by whole
+//      text lines; moving the scan bytes costs the whole plane, moving
+//      row pointers costs one pointer per scan line.
+//
+//      The table lies twice over in a ring of 2 * height pointers, with
+//      the table starting at rowOrigin.  Scrolling only moves the origin,
+//      since every height consecutive pointers of the ring form a valid
+//      rotation of the table.  Other row operations permute pointers at
+//      the table then copy them to the other side of the ring.  Inserted
+//      and deleted scan lines recycle the scan lines pushed off an edge,
+//      clearing them.
+//
+//      Row operations damage the scan lines they move.  With occupancy
+//      tracking, the summary moves with its scan lines, one summary word
+//      per 64 scan words, so that nothing rereads the scan bytes.
+//
+//      Unindexing undoes the permutation in place, cycle by cycle, with
+//      one scan line of scratch space.  It preserves any padding bits
+//      beyond the width in each scan line's last scan byte, since those
+//      may belong to another plane.
+//
+//**********************************************************************
+
+bool BitPlane::indexRows() {
+  if (width <= 0 || height <= 0)
+    return false;
+  // Unindex first so that re-indexing an indexed plane finds its rows.
+  if (rowTable != nullptr && !unindexRows())
+    return false;
+  rowPointers.resize(2U * static_cast<std::size_t>(height));
+  rowOrigin = 0;
+  rowTable = rowPointers.data();
+  for (int row = 0; row < height; ++row)
+    rowTable[row] = store + widthScanBytes * row;
+  mirrorRows(0, height);
+  return true;
+}
+
+bool BitPlane::unindexRows() {
+  if (rowTable == nullptr)
+    return true;
+  // Scan line y must land at store + widthScanBytes * y: every row
+  // pointer must point at one of the plane's own scan lines.
+  std::vector<int> from(height);
+  std::vector<bool> seen(height, false);
+  for (int row = 0; row < height; ++row) {
+    const std::ptrdiff_t offset = rowTable[row] - store;
+    if (offset < 0 || offset % widthScanBytes != 0 || offset / widthScanBytes >= height ||
+        seen[offset / widthScanBytes])
+      return false;
+    from[row] = static_cast<int>(offset / widthScanBytes);
+    seen[from[row]] = true;
+  }
+  const std::size_t scanByteCount = (static_cast<std::size_t>(width) + 7U) >> 3;
+  const scanbyte lastMask = 0xffU << (7 - ((width - 1) & 7));
+  const auto copyRow = [&](scanbyte *d, const scanbyte *s) {
+    (void)memcpy(d, s, scanByteCount - 1U);
+    d[scanByteCount - 1U] = (d[scanByteCount - 1U] & ~lastMask) | (s[scanByteCount - 1U] & lastMask);
+  };
+  std::vector<scanbyte> scratch(scanByteCount);
+  for (int row = 0; row < height; ++row) {
+    if (from[row] == row)
+      continue;
+    // Follow the cycle through row: each scan line takes its successor's
+    // scan bytes; the last takes row's, saved beforehand.
+    scanbyte *first = store + widthScanBytes * row;
+    (void)memcpy(scratch.data(), first, scanByteCount);
+    int to = row;
+    while (from[to] != row) {
+      copyRow(store + widthScanBytes * to, store + widthScanBytes * from[to]);
+      const int next = from[to];
+      from[to] = to;
+      to = next;
+    }
+    copyRow(store + widthScanBytes * to, scratch.data());
+    from[to] = to;
+  }
+  rowPointers.clear();
+  rowOrigin = 0;
+  rowTable = nullptr;
+  return true;
+}
+
+void BitPlane::mirrorRows(int y, int cy) {
+  for (int row = y; row < y + cy; ++row) {
+    const int ring = rowOrigin + row;
+    rowPointers[ring < height ? ring + height : ring - height] = rowPointers[ring];
+  }
+}
+
+template <typename Permute> void BitPlane::permuteRows(int y, int cy, Permute permute) {
+  permute(rowTable + y, rowTable + y + cy);
+  mirrorRows(y, cy);
+  if (trackingOccupancy) {
+    std::vector<int> order(cy);
+    std::iota(order.begin(), order.end(), y);
+    permute(order.begin(), order.end());
+    permuteOccupancy(y, order);
+  }
+  if (trackingDamage)
+    recordDamage(0, y, width, cy);
+}
+
+void BitPlane::permuteOccupancy(int y, const std::vector<int> &order) {
+  std::vector<std::uint64_t> moved(occupancyStride * order.size());
+  for (std::size_t i = 0; i < order.size(); ++i)
+    std::copy_n(occupancy.begin() + occupancyStride * order[i], occupancyStride, moved.begin() + occupancyStride * i);
+  std::copy(moved.begin(), moved.end(), occupancy.begin() + occupancyStride * y);
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    const std::size_t row = y + i;
+    const std::uint64_t bit = std::uint64_t(1U) << (row & 63U);
+    if (std::any_of(moved.begin() + occupancyStride * i, moved.begin() + occupancyStride * (i + 1U),
+                    [](std::uint64_t word) { return word != 0U; }))
+      occupiedRows[row >> 6] |= bit;
+    else
+      occupiedRows[row >> 6] &= ~bit;
+  }
+}
+
+bool BitPlane::scrollRows(int dy) {
+  if (rowTable == nullptr)
+    return false;
+  const int n = ((dy % height) + height) % height;
+  if (n == 0)
+    return true;
+  rowOrigin = (rowOrigin + height - n) % height;
+  rowTable = rowPointers.data() + rowOrigin;
+  if (trackingOccupancy) {
+    std::vector<int> order(height);
+    for (int row = 0; row < height; ++row)
+      order[row] = (row + height - n) % height;
+    permuteOccupancy(0, order);
+  }
+  if (trackingDamage)
+    recordDamage(0, 0, width, height);
+  return true;
+}
+
+bool BitPlane::insertRows(int y, int cy) {
+  if (rowTable == nullptr || y < 0 || y >= height || cy <= 0)
+    return false;
+  cy = std::min(cy, height - y);
+  permuteRows(y, height - y, [cy](auto first, auto last) { std::rotate(first, last - cy, last); });
+  fill(0, y, width, cy, rop0);
+  touch(0, y, width, cy);
+  return true;
+}
+
+bool BitPlane::deleteRows(int y, int cy) {
+  if (rowTable == nullptr || y < 0 || y >= height || cy <= 0)
+    return false;
+  cy = std::min(cy, height - y);
+  permuteRows(y, height - y, [cy](auto first, auto last) { std::rotate(first, first + cy, last); });
+  fill(0, height - cy, width, cy, rop0);
+  touch(0, height - cy, width, cy);
+  return true;
+}
+
+bool BitPlane::swapRows(int y0, int y1) {
+  if (rowTable == nullptr || y0 < 0 || y0 >= height || y1 < 0 || y1 >= height)
+    return false;
+  if (y0 != y1)
+    permuteRows(std::min(y0, y1), std::abs(y1 - y0) + 1,
+                [](auto first, auto last) { std::iter_swap(first, last - 1); });
+  return true;
+}
+
+bool BitPlane::flipRows() {
+  if (rowTable == nullptr)
+    return false;
+  permuteRows(0, height, [](auto first, auto last) { std::reverse(first, last); });
+  return true;
+}
+
+//**********************************************************************
+//                                                   BitPlane::shiftBits
+//**********************************************************************
+//
+//**    Synopsis
+//
+//      bool shiftBits(x, y, cx, cy, dx, wrap)
+//
+//**    Description
+//
+//      Blitting a plane onto itself to scroll sideways misbehaves when
+//      source and destination overlap, and phase-aligns one scan byte at
+//      a time.  Shifting bits instead works in place on 64-bit groups of
+//      each scan line, aligned to the scan byte grid.  Shifting right
+//      visits the groups right to left, shifting left visits them left
+//      to right, so that every group reads its source bits before any
+//      store overwrites them.
+//
+//      Rotating by r pixels first saves the r pixels about to fall off
+//      one end, shifts, then stores the saved pixels at the other end.
+//      Rotating right by r equals rotating left by cx - r; the rotation
+//      goes whichever way saves fewer pixels.
+//
+//**********************************************************************
+
+bool BitPlane::shiftBits(int x, int y, int cx, int cy, int dx, bool wrap) {
+  // Negative extents put the origin at the far edge, as for blits.
+  if (cx < 0) {
+    cx = -cx;
+    x -= cx;
+  }
+  if (cy < 0) {
+    cy = -cy;
+    y -= cy;
+  }
+  if (x < 0) {
+    cx += x;
+    x = 0;
+  }
+  if (y < 0) {
+    cy += y;
+    y = 0;
+  }
+  cx = std::min(cx, width - x);
+  cy = std::min(cy, height - y);
+  if (cx <= 0 || cy <= 0)
+    return false;
+  if (wrap) {
+    dx %= cx;
+    if (dx < 0)
+      dx += cx;
+    if (cx - dx < dx)
+      dx -= cx;
+  } else
+    dx = std::clamp(dx, -cx, cx);
+  if (dx == 0)
+    return true;
+  const int lo = x;
+  const int hi = x + cx;
+  // Pixels beyond the clip mask never change.
+  const int hiStore = clipMask != nullptr ? std::min(hi, clipMask->width) : hi;
+  const int first = x & ~7;
+  const int last = first + (hi - 1 - first) / 64 * 64;
+  const int saved = wrap ? std::abs(dx) : 0;
+  std::vector<scanword> wrapped((saved + 63) / 64);
+  for (int row = y; row < y + cy; ++row) {
+    const scanbyte *clip = nullptr;
+    if (clipMask != nullptr) {
+      if (row >= clipMask->height)
+        break;
+      clip = clipMask->findBits(0, row);
+    }
+    scanbyte *scan = findBits(0, row);
+    const int wrapFrom = dx > 0 ? hi - saved : lo;
+    for (std::size_t i = 0; i < wrapped.size(); ++i)
+      wrapped[i] = loadBits(scan, wrapFrom + 64 * static_cast<int>(i), wrapFrom, wrapFrom + saved);
+    if (dx > 0)
+      for (int group = last; group >= first; group -= 64)
+        storeBits(scan, group, loadBits(scan, group - dx, lo, hi), lo, hiStore, clip);
+    else
+      for (int group = first; group <= last; group += 64)
+        storeBits(scan, group, loadBits(scan, group - dx, lo, hi), lo, hiStore, clip);
+    const int wrapTo = dx > 0 ? lo : hi - saved;
+    for (std::size_t i = 0; i < wrapped.size(); ++i)
+      storeBits(scan, wrapTo + 64 * static_cast<int>(i), wrapped[i], wrapTo, std::min(wrapTo + saved, hiStore), clip);
+  }
+  touch(x, y, cx, cy);
+  return true;
+}
+
+//**********************************************************************
+//                                                 BitPlane::setClipMask
+//**********************************************************************
+//
+//**    Synopsis
+//
+//      void setClipMask(clipMask)
+//      const BitPlane* clipMask;       // clip mask or nullptr
+//
+//**    Description
+//
+//      A clip mask restricts drawing to arbitrary shapes.  Its pixels
+//      correspond one-to-one with ``this'' plane's pixels; drawing only
+//      changes destination pixels where the mask has ones.  Destination
+//      pixels beyond the mask's width or height never change.  Blits,
+//      fills, region blits, atomic blits and plane expressions all
+//      honour the mask.  Mask scan bytes load in the same loop as the
+//      source scan bytes, one per destination scan byte, so clipping
+//      needs no extra pass.  The mask must outlive its attachment, and
+//      must not be the destination of drawing while attached.
+//
+//**********************************************************************
+
+void BitPlane::setClipMask(const BitPlane *clipMask) { this->clipMask = clipMask; }
+
+bool BitPlane::clipExtent(int x, int y, int &cx, int &cy) const {
+  if (clipMask->width <= x || clipMask->height <= y)
+    return false;
+  cx = std::min(cx, clipMask->width - x);
+  cy = std::min(cy, clipMask->height - y);
+  return true;
+}
 
 //**********************************************************************
 //                                                      BitPlane::bitBlt
@@ -196,6 +929,10 @@ inline const scanbyte *BitPlane::bits(int x, int y) const { return findBits(x, y
 //
 //      bool bitBlt(x, y, cx, cy, bitPlaneSrc, xSrc, ySrc, rop2)
 //      bool bitBlt(x, y, cx, cy, rop1)
+//      bool bitBlt(policy, x, y, cx, cy, bitPlaneSrc, xSrc, ySrc, rop2)
+//      bool bitBlt(policy, x, y, cx, cy, rop1)
+//      const execution::sequenced_policy& policy; or
+//      const execution::parallel_policy& policy;
 //      int x;                          // horizontal destination origin
 //      int y;                          // vertical destination origin
 //      int cx;                         // horizontal extent
@@ -237,9 +974,167 @@ inline const scanbyte *BitPlane::bits(int x, int y) const { return findBits(x, y
 //      vely.  Operation ``DSon'' for example means bitwise-OR destination
 //      and source then invert.
 //
+//      An execution policy as first argument selects how to run the
+//      transfer.  Policy execution::seq is the same as no policy at all.
+//      Policies execution::par and par_unseq partition the clipped
+//      rectangle into bands of scan lines and transfer the bands on
+//      separate threads.  Blits smaller than the policy's grain run as
+//      one band on the calling thread; small blits never pay for
+//      threads.
+//
 //**********************************************************************
 
 bool BitPlane::bitBlt(int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc, int xSrc, int ySrc, Rop2 rop2) {
+  if (!clip(x, y, cx, cy, bitPlaneSrc, xSrc, ySrc))
+    return false;
+  transfer(x, y, cx, cy, bitPlaneSrc, xSrc, ySrc, rop2);
+  touch(x, y, cx, cy);
+  return true;
+}
+
+bool BitPlane::bitBlt(int x, int y, int cx, int cy, Rop1 rop1) {
+  // Convert it to a binary raster-operation, specifying the destination
+  // as the source.  The operation never fetches from the source, so
+  // transfer hands it to fill, which needs no PhaseAlign functor.
+  return bitBlt(x, y, cx, cy, *this, x, y, Rop2(rop1));
+}
+
+bool BitPlane::bitBlt(const execution::sequenced_policy &, int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc,
+                      int xSrc, int ySrc, Rop2 rop2) {
+  return bitBlt(x, y, cx, cy, bitPlaneSrc, xSrc, ySrc, rop2);
+}
+
+bool BitPlane::bitBlt(const execution::sequenced_policy &, int x, int y, int cx, int cy, Rop1 rop1) {
+  return bitBlt(x, y, cx, cy, rop1);
+}
+
+// Parallel blits clip once then split the clipped rectangle into bands
+// of whole scan lines.  No two bands share a destination scan byte, so
+// the bands transfer concurrently without synchronisation.  The usual
+// overlap caveat applies: if source and destination overlap, the out-
+// come is undefined---more so with several threads in flight.
+bool BitPlane::bitBlt(const execution::parallel_policy &policy, int x, int y, int cx, int cy,
+                      const BitPlane &bitPlaneSrc, int xSrc, int ySrc, Rop2 rop2) {
+  if (!clip(x, y, cx, cy, bitPlaneSrc, xSrc, ySrc))
+    return false;
+  const std::size_t scanBytes = ((x + cx - 1) >> 3) - (x >> 3) + 1;
+  execution::forEachBand(policy, cy, scanBytes, [&](int yBand, int cyBand) {
+    transfer(x, y + yBand, cx, cyBand, bitPlaneSrc, xSrc, ySrc + yBand, rop2);
+    touch(x, y + yBand, cx, cyBand);
+  });
+  return true;
+}
+
+bool BitPlane::bitBlt(const execution::parallel_policy &policy, int x, int y, int cx, int cy, Rop1 rop1) {
+  return bitBlt(policy, x, y, cx, cy, *this, x, y, Rop2(rop1));
+}
+
+//**********************************************************************
+//                                                BitPlane::bitBltAtomic
+//**********************************************************************
+//
+//**    Synopsis
+//
+//      bool bitBltAtomic(x, y, cx, cy, bitPlaneSrc, xSrc, ySrc, rop2)
+//
+//**    Description
+//
+//      BitBltAtomic works like bitBlt but stores the left and right
+//      edge scan bytes of every scan line using atomic read-modify-write
+//      operations.  Several threads may therefore blit concurrently into
+//      the same destination plane provided that their destination rect-
+//      angles do not overlap: rectangles may share edge scan bytes but
+//      not interior scan bytes, which store non-atomically.  Only the
+//      raster operations with an atomic equivalent qualify: srcPaint
+//      (fetch-or), srcAnd (fetch-and) and srcInvert (fetch-xor).  Any
+//      other operation answers false without transferring.
+//
+//**********************************************************************
+
+bool BitPlane::bitBltAtomic(int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc, int xSrc, int ySrc,
+                            Rop2 rop2) {
+  if (rop2 != srcPaint && rop2 != srcAnd && rop2 != srcInvert)
+    return false;
+  if (!clip(x, y, cx, cy, bitPlaneSrc, xSrc, ySrc))
+    return false;
+  mark(x, y, cx, cy);
+  if (clipMask != nullptr) {
+    ClipBlt<AtomicBlt> blt(rop2);
+    transfer(blt, x, y, cx, cy, bitPlaneSrc, xSrc, ySrc);
+  } else {
+    AtomicBlt blt(rop2);
+    transfer(blt, x, y, cx, cy, bitPlaneSrc, xSrc, ySrc);
+  }
+  return true;
+}
+
+//**********************************************************************
+//                                                BitPlane::bitBlt(region)
+//**********************************************************************
+//
+//**    Synopsis
+//
+//      bool bitBlt(region, x, y, cx, cy, bitPlaneSrc, xSrc, ySrc, rop2)
+//      bool bitBlt(region, x, y, cx, cy, rop1)
+//      const Region& region;           // clip region
+//
+//**    Description
+//
+//      Region blits transfer only those destination bits lying within
+//      the clip region, as well as within both planes.  Clipping against
+//      the planes happens first, once.  The transfer then visits the
+//      region's rectangles in banded order, top to bottom, skipping
+//      those that miss the clipped rectangle and stopping at the first
+//      band below it.  One Blt functor and one set of PhaseAlign
+//      functors serve every piece, no matter how many rectangles; each
+//      piece only re-selects the shift, since moving both origins by the
+//      same amount can move them across scan byte boundaries different-
+//      ly.  Answers false if nothing transfers.
+//
+//**********************************************************************
+
+bool BitPlane::bitBlt(const Region &region, int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc, int xSrc,
+                      int ySrc, Rop2 rop2) {
+  if (!clip(x, y, cx, cy, bitPlaneSrc, xSrc, ySrc))
+    return false;
+  if (clipMask != nullptr) {
+    ClipBlt<Blt> blt(rop2);
+    return transfer(blt, region, x, y, cx, cy, bitPlaneSrc, xSrc, ySrc);
+  }
+  Blt blt(rop2);
+  return transfer(blt, region, x, y, cx, cy, bitPlaneSrc, xSrc, ySrc);
+}
+
+bool BitPlane::bitBlt(const Region &region, int x, int y, int cx, int cy, Rop1 rop1) {
+  return bitBlt(region, x, y, cx, cy, *this, x, y, Rop2(rop1));
+}
+
+//**********************************************************************
+//                                                        BitPlane::clip
+//**********************************************************************
+//
+//**    Synopsis
+//
+//      bool clip(x, y, cx, cy, bitPlaneSrc, xSrc, ySrc)
+//      int& x;                         // horizontal destination origin
+//      int& y;                         // vertical destination origin
+//      int& cx;                        // horizontal extent
+//      int& cy;                        // vertical extent
+//      const BitPlane& bitPlaneSrc;    // source bit-plane
+//      int& xSrc;                      // horizontal source origin
+//      int& ySrc;                      // vertical source origin
+//
+//**    Description
+//
+//      Clip normalises and clips a transfer rectangle in-place against
+//      ``this'' destination plane, the source plane and the clip mask.  It answers
+//      false if nothing remains to transfer.  On true, the origins are
+//      non-negative and the extents positive, and the rectangle lies
+//      wholly within both planes.
+//
+//**********************************************************************
+
+bool BitPlane::clip(int &x, int &y, int &cx, int &cy, const BitPlane &bitPlaneSrc, int &xSrc, int &ySrc) const {
   // Normalize the extents.  Extents are normally positive.  A negative
   // extent means the destination and source origins specify the far
   // edge of the rectangle.  Two's-complement negative extents and put
@@ -315,28 +1210,206 @@ bool BitPlane::bitBlt(int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc,
     return false;
   if (cyMax < cy)
     cy = cyMax;
+  // Pixels beyond the clip mask, if any, are clipped away.
+  return clipMask == nullptr || clipExtent(x, y, cx, cy);
+}
 
-  // Decide how to fetch the source bits.  There are three PhaseAlign
-  // functors to choose from, based on how the bits are out of phase.
-  // The destination alignment is x & 7, i.e. how many bits from the
-  // left side of the scan byte.  Expression xSrc & 7 gives the source
-  // alignment.  The sign and magnitude of the difference between the
-  // alignments determines the direction and amount of shift.
+//**********************************************************************
+//                                                    BitPlane::transfer
+//**********************************************************************
+//
+//**    Description
+//
+//      Transfer runs the fetch-logic-store loop over a rectangle already
+//      clipped by clip().  It neither normalises nor checks its argum-
+//      ents.  Splitting a clipped rectangle into horizontal bands and
+//      transferring each band gives the same result as transferring the
+//      whole; parallel blits rely on that.
+//
+//**********************************************************************
+
+void BitPlane::transfer(int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc, int xSrc, int ySrc, Rop2 rop2) {
+  if (clipMask == nullptr) {
+    if (!ropUsesSource(rop2)) {
+      fill(x, y, cx, cy, rop2);
+      return;
+    }
+    if (detectingUniform) {
+      transferUniform(x, y, cx, cy, bitPlaneSrc, xSrc, ySrc, rop2);
+      return;
+    }
+  }
+  if (clipMask != nullptr) {
+    ClipBlt<Blt> blt(rop2);
+    transfer(blt, x, y, cx, cy, bitPlaneSrc, xSrc, ySrc);
+    return;
+  }
   Blt blt(rop2);
-  PhaseAlign fetch;
-  RightShift fetchRightShift;
-  LeftShift fetchLeftShift;
-  int shiftCount = (x & 7) - (xSrc & 7);
-  if (shiftCount < 0) {
-    fetchLeftShift.shiftCount = -shiftCount;
-    blt.phaseAlign = &fetchLeftShift;
-  } else if (shiftCount == 0)
-    blt.phaseAlign = &fetch;
-  else {
-    fetchRightShift.shiftCount = shiftCount;
-    blt.phaseAlign = &fetchRightShift;
+  transfer(blt, x, y, cx, cy, bitPlaneSrc, xSrc, ySrc);
+}
+
+//**********************************************************************
+//                                                        BitPlane::fill
+//**********************************************************************
+//
+//**    Description
+//
+//      Raster operations that ignore the source, rop0, ropDn, ropD and
+//      rop1, need no Blt functor: fill clears, inverts or sets the dest-
+//      ination bits directly, masking the edge scan bytes and running
+//      memset or an inverting loop over the interior.  Operation ropD
+//      changes nothing.  Fill does not handle clip masks; transfer only
+//      calls it without one.
+//
+//**********************************************************************
+
+void BitPlane::fill(int x, int y, int cx, int cy, Rop2 rop2) {
+  if (rop2 == ropD)
+    return;
+  const int xMax = x + cx - 1;
+  const int extraScanByteCount = (xMax >> 3) - (x >> 3);
+  scanbyte scanOrgMask = 0xffU >> (x & 7);
+  const scanbyte scanExtMask = 0xffU << (7 - (xMax & 7));
+  if (extraScanByteCount == 0)
+    scanOrgMask &= scanExtMask;
+  const scanbyte v = rop2 == rop1 ? 0xffU : 0x00U;
+  for (int row = 0; row < cy; ++row) {
+    scanbyte *d = findBits(x, y + row);
+    if (rop2 == ropDn) {
+      *d ^= scanOrgMask;
+      if (extraScanByteCount == 0)
+        continue;
+      for (int i = 1; i < extraScanByteCount; ++i)
+        d[i] = static_cast<scanbyte>(~d[i]);
+      d[extraScanByteCount] ^= scanExtMask;
+      continue;
+    }
+    *d = (*d & ~scanOrgMask) | (v & scanOrgMask);
+    if (extraScanByteCount == 0)
+      continue;
+    (void)memset(d + 1, v, static_cast<std::size_t>(extraScanByteCount - 1));
+    d[extraScanByteCount] = (d[extraScanByteCount] & ~scanExtMask) | (v & scanExtMask);
   }
+}
 
+//**********************************************************************
+//                                             BitPlane::transferUniform
+//**********************************************************************
+//
+//**    Description
+//
+//      Where the source bits of a scan line are all zeros or all ones,
+//      any binary raster operation collapses to a unary one: bits 2S and
+//      2S+1 of the truth table give the result for destination bits 0
+//      and 1, a two-bit table which, repeated, is the unary operation's
+//      code.  Fill then runs instead of fetching and shifting the
+//      source.  Only planes detecting uniform sources look: uniformity
+//      costs nothing for scan lines the source's occupancy summary shows
+//      empty; otherwise a wide scan of the source scan line exits at the
+//      first scan word holding both zeros and ones.  Consecutive scan
+//      lines of the same kind transfer together.
+//
+//**********************************************************************
+
+static_assert(unaryRop(srcCopy, 0) == rop0 && unaryRop(srcCopy, 1) == rop1);
+static_assert(unaryRop(srcInvert, 0) == ropD && unaryRop(srcInvert, 1) == ropDn);
+
+int BitPlane::uniformity(int x, int y, int cx) const {
+  if (trackingOccupancy && !isRowOccupied(y))
+    return 0;
+  const int xMax = x + cx - 1;
+  const int extraScanByteCount = (xMax >> 3) - (x >> 3);
+  scanbyte scanOrgMask = 0xffU >> (x & 7);
+  const scanbyte scanExtMask = 0xffU << (7 - (xMax & 7));
+  if (extraScanByteCount == 0)
+    scanOrgMask &= scanExtMask;
+  const scanbyte *p = findBits(x, y);
+  scanbyte any = *p & scanOrgMask;
+  scanbyte all = *p | static_cast<scanbyte>(~scanOrgMask);
+  if (extraScanByteCount > 0) {
+    any |= p[extraScanByteCount] & scanExtMask;
+    all &= p[extraScanByteCount] | static_cast<scanbyte>(~scanExtMask);
+  }
+  if (any != 0x00U && all != 0xffU)
+    return -1;
+  int i = 1;
+  for (; i + static_cast<int>(sizeof(scanword)) <= extraScanByteCount; i += sizeof(scanword)) {
+    const scanword w = loadScanWord(p + i);
+    if ((any != 0x00U || w != 0U) && (all != 0xffU || w != ~scanword(0U)))
+      return -1;
+    any |= w != 0U ? 0xffU : 0x00U;
+    all &= w == ~scanword(0U) ? 0xffU : 0x00U;
+  }
+  for (; i < extraScanByteCount; ++i) {
+    any |= p[i];
+    all &= p[i];
+    if (any != 0x00U && all != 0xffU)
+      return -1;
+  }
+  return any == 0x00U ? 0 : 1;
+}
+
+void BitPlane::transferUniform(int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc, int xSrc, int ySrc,
+                               Rop2 rop2) {
+  const auto kindOf = [&](int row) { return bitPlaneSrc.uniformity(xSrc, ySrc + row, cx); };
+  int kind = kindOf(0);
+  for (int row = 0; row < cy;) {
+    int rows = 1;
+    int next = -1;
+    while (row + rows < cy && (next = kindOf(row + rows)) == kind)
+      ++rows;
+    if (kind < 0) {
+      Blt blt(rop2);
+      transfer(blt, x, y + row, cx, rows, bitPlaneSrc, xSrc, ySrc + row);
+    } else
+      fill(x, y + row, cx, rows, unaryRop(rop2, kind));
+    row += rows;
+    kind = next;
+  }
+}
+
+// The Blt functor type is a template parameter so that derived functors
+// such as AtomicBlt can hide fetchLogicStore without paying for virtual
+// dispatch on every scan byte.
+template <typename BltFunctor>
+void BitPlane::transfer(BltFunctor &blt, int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc, int xSrc,
+                        int ySrc) {
+  PhaseSelect phase;
+  blt.phaseAlign = phase.select(x, xSrc);
+  transferRows(blt, x, y, cx, cy, bitPlaneSrc, xSrc, ySrc);
+}
+
+// Region transfers clip each of the region's rectangles against the
+// clipped transfer rectangle; see bitBlt(region, ...).
+template <typename BltFunctor>
+bool BitPlane::transfer(BltFunctor &blt, const Region &region, int x, int y, int cx, int cy,
+                        const BitPlane &bitPlaneSrc, int xSrc, int ySrc) {
+  PhaseSelect phase;
+  const int xMax = x + cx;
+  const int yMax = y + cy;
+  bool transferred = false;
+  for (const Rect &rect : region.getRects()) {
+    if (rect.y >= yMax)
+      break;
+    const int x0 = std::max(rect.x, x);
+    const int x1 = std::min(rect.x + rect.cx, xMax);
+    const int y0 = std::max(rect.y, y);
+    const int y1 = std::min(rect.y + rect.cy, yMax);
+    if (x0 >= x1 || y0 >= y1)
+      continue;
+    blt.phaseAlign = phase.select(x0, xSrc + (x0 - x));
+    transferRows(blt, x0, y0, x1 - x0, y1 - y0, bitPlaneSrc, xSrc + (x0 - x), ySrc + (y0 - y));
+    touch(x0, y0, x1 - x0, y1 - y0);
+    transferred = true;
+  }
+  return transferred;
+}
+
+// TransferRows runs the scan loop for a Blt functor whose phaseAlign is
+// already set up for the origins.
+template <typename BltFunctor>
+void BitPlane::transferRows(BltFunctor &blt, int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc, int xSrc,
+                            int ySrc) {
   // This blit implementation always iterates down the scan lines top-
   // to-bottom, and steps across the scan-line scan bytes left-to-right.
   // Stepping directions matter when the source plane is ``this'' plane
@@ -360,6 +1433,32 @@ bool BitPlane::bitBlt(int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc,
   const int displaceSrc = bitPlaneSrc.widthScanBytes - 1 - extraScanByteCount;
   blt.store = findBits(x, y);
   blt.phaseAlign->store = bitPlaneSrc.findBits(xSrc, ySrc);
+  // Clipping functors step through the clip mask alongside the destin-
+  // ation; clip() has already clipped the rectangle to the mask.
+  constexpr bool clipping = requires { blt.clip; };
+  int displaceClip = 0;
+  if constexpr (clipping) {
+    blt.clip = clipMask->findBits(x, y);
+    displaceClip = clipMask->widthScanBytes - 1 - extraScanByteCount;
+  }
+  // Scan lines of indexed planes lie wherever their row tables say, so
+  // stepping to the next scan line looks every operand up afresh.
+  bool indexed = rowTable != nullptr || bitPlaneSrc.rowTable != nullptr;
+  if constexpr (clipping)
+    indexed = indexed || clipMask->rowTable != nullptr;
+  const auto nextRow = [&] {
+    if (indexed) {
+      blt.store = findBits(x, ++y);
+      blt.phaseAlign->store = bitPlaneSrc.findBits(xSrc, ++ySrc);
+      if constexpr (clipping)
+        blt.clip = clipMask->findBits(x, y);
+      return;
+    }
+    blt.store += displace;
+    blt.phaseAlign->store += displaceSrc;
+    if constexpr (clipping)
+      blt.clip += displaceClip;
+  };
   if (extraScanByteCount == 0) {
     // The scan line's bits begin and end in the same scan byte.  There's
     // just one fetchLogicStore every scan line, so optimize the blit
@@ -368,8 +1467,7 @@ bool BitPlane::bitBlt(int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc,
     while (cy--) {
       blt.phaseAlign->prefetch();
       blt.fetchLogicStore(scanMask);
-      blt.store += displace;
-      blt.phaseAlign->store += displaceSrc;
+      nextRow();
     }
   } else {
     while (cy--) {
@@ -379,20 +1477,9 @@ bool BitPlane::bitBlt(int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc,
       while (--scanByteCount)
         blt.fetchLogicStore();
       blt.fetchLogicStore(scanExtMask);
-      blt.store += displace;
-      blt.phaseAlign->store += displaceSrc;
+      nextRow();
     }
   }
-  return true;
-}
-
-bool BitPlane::bitBlt(int x, int y, int cx, int cy, Rop1 rop1) {
-  // Unary operations aren't fully optimized in this version of BitPlane.
-  // Convert it to a binary raster-operation, specifying the destination
-  // as the source.  BitBlt will set up the PhaseAlign functor unnecess-
-  // arily, but because it is unary the operation will not fetch bits
-  // from the source.
-  return bitBlt(x, y, cx, cy, *this, x, y, Rop2(rop1));
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file bit_sliced_counter.cxx
+/// \brief Per-pixel counters stored as a stack of bit planes.
+/// \details This file contains the implementation of the BitSlicedCounter class.
+
+#include "raster/bit_sliced_counter.hxx"
+
+namespace raster {
+
+bool BitSlicedCounter::create(int cx, int cy, int bitCount) {
+  if (bitCount < 1 || bitCount > 32)
+    return false;
+  std::vector<BitPlane> planes(bitCount);
+  for (BitPlane &plane : planes)
+    if (!plane.create(cx, cy))
+      return false;
+  slices.swap(planes);
+  width = slices[0].getWidth();
+  height = slices[0].getHeight();
+  clear();
+  return true;
+}
+
+void BitSlicedCounter::clear() {
+  for (BitPlane &plane : slices)
+    (void)plane.bitBlt(0, 0, width, height, blackness);
+}
+
+//**********************************************************************
+//                                                BitSlicedCounter::add
+//**********************************************************************
+//
+//**    Description
+//
+//      Both forms of add run a ripple-carry adder down the slices, one
+//      scan word at a time.  The addend for slice i is either the mask
+//      word or zero, depending on bit i of the value; or slice i of the
+//      other counter.  Addend bits beyond the top slice overflow at once.
+//      Once the carry is zero and no addend bits remain, higher slices
+//      cannot change and the adder stops early.
+//
+//**********************************************************************
+
+bool BitSlicedCounter::add(const BitPlane &mask, unsigned value) {
+  if (mask.getWidth() != width || mask.getHeight() != height || slices.empty())
+    return false;
+  const int bitCount = getBitCount();
+  const unsigned valueOverflow = bitCount < 32 ? value >> bitCount : 0U;
+  const std::size_t scanByteCount = (static_cast<std::size_t>(width) + 7U) >> 3;
+  std::vector<scanbyte *> scans(bitCount);
+  for (int y = 0; y < height; ++y) {
+    for (int i = 0; i < bitCount; ++i)
+      scans[i] = slices[i].bits(0, y);
+    const scanbyte *scanMask = mask.bits(0, y);
+    forEachScan(scanByteCount, [&](std::size_t offset, auto unit) {
+      using Word = decltype(unit);
+      const Word m = loadScan<Word>(scanMask + offset);
+      if (m == 0)
+        return;
+      Word carry = 0;
+      for (int i = 0; i < bitCount; ++i) {
+        if (carry == 0 && (value >> i) == 0)
+          break;
+        const Word a = loadScan<Word>(scans[i] + offset);
+        const Word b = (value >> i) & 1U ? m : Word(0);
+        storeScan<Word>(scans[i] + offset, a ^ b ^ carry);
+        carry = (a & b) | (carry & (a ^ b));
+      }
+      const Word overflow = carry | (valueOverflow != 0U ? m : Word(0));
+      if (saturating && overflow != 0)
+        for (int i = 0; i < bitCount; ++i)
+          storeScan<Word>(scans[i] + offset, loadScan<Word>(scans[i] + offset) | overflow);
+    });
+  }
+  return true;
+}
+
+bool BitSlicedCounter::add(const BitSlicedCounter &counter) {
+  if (counter.width != width || counter.height != height || slices.empty())
+    return false;
+  const int bitCount = getBitCount();
+  const int bitCountOther = counter.getBitCount();
+  const std::size_t scanByteCount = (static_cast<std::size_t>(width) + 7U) >> 3;
+  std::vector<scanbyte *> scans(bitCount);
+  std::vector<const scanbyte *> scansOther(bitCountOther);
+  for (int y = 0; y < height; ++y) {
+    for (int i = 0; i < bitCount; ++i)
+      scans[i] = slices[i].bits(0, y);
+    for (int i = 0; i < bitCountOther; ++i)
+      scansOther[i] = counter.slices[i].bits(0, y);
+    forEachScan(scanByteCount, [&](std::size_t offset, auto unit) {
+      using Word = decltype(unit);
+      Word carry = 0;
+      for (int i = 0; i < bitCount; ++i) {
+        const Word b = i < bitCountOther ? loadScan<Word>(scansOther[i] + offset) : Word(0);
+        if (carry == 0 && b == 0 && i >= bitCountOther)
+          break;
+        const Word a = loadScan<Word>(scans[i] + offset);
+        storeScan<Word>(scans[i] + offset, a ^ b ^ carry);
+        carry = (a & b) | (carry & (a ^ b));
+      }
+      Word overflow = carry;
+      for (int i = bitCount; i < bitCountOther; ++i)
+        overflow |= loadScan<Word>(scansOther[i] + offset);
+      if (saturating && overflow != 0)
+        for (int i = 0; i < bitCount; ++i)
+          storeScan<Word>(scans[i] + offset, loadScan<Word>(scans[i] + offset) | overflow);
+    });
+  }
+  return true;
+}
+
+// BitSlicedCounter::threshold(bitPlane, threshold)
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Compare from the most significant slice down.  Lanes still equal to
+// the threshold so far become greater where the slice has a one and the
+// threshold a zero, and drop out where the slice has a zero and the
+// threshold a one.  Lanes greater or equal at the end pass.
+
+bool BitSlicedCounter::threshold(BitPlane &bitPlane, unsigned threshold) const {
+  if (bitPlane.getWidth() != width || bitPlane.getHeight() != height || slices.empty())
+    return false;
+  const int bitCount = getBitCount();
+  const bool unreachable = bitCount < 32 && (threshold >> bitCount) != 0U;
+  const std::size_t scanByteCount = (static_cast<std::size_t>(width) + 7U) >> 3;
+  const scanbyte scanExtMask = 0xffU << ((8 - (width & 7)) & 7);
+  std::vector<const scanbyte *> scans(bitCount);
+  for (int y = 0; y < height; ++y) {
+    for (int i = 0; i < bitCount; ++i)
+      scans[i] = slices[i].bits(0, y);
+    scanbyte *store = bitPlane.bits(0, y);
+    const scanbyte last = store[scanByteCount - 1];
+    forEachScan(scanByteCount, [&](std::size_t offset, auto unit) {
+      using Word = decltype(unit);
+      Word gt = 0;
+      Word eq = static_cast<Word>(~Word(0));
+      for (int i = bitCount - 1; i >= 0; --i) {
+        const Word s = loadScan<Word>(scans[i] + offset);
+        if ((threshold >> i) & 1U)
+          eq &= s;
+        else {
+          gt |= eq & s;
+          eq &= ~s;
+        }
+      }
+      storeScan<Word>(store + offset, unreachable ? Word(0) : static_cast<Word>(gt | eq));
+    });
+    store[scanByteCount - 1] = (last & ~scanExtMask) | (store[scanByteCount - 1] & scanExtMask);
+  }
+  bitPlane.touch(0, 0, width, height);
+  return true;
+}
+
+unsigned BitSlicedCounter::count(int x, int y) const {
+  if (x < 0 || x >= width || y < 0 || y >= height)
+    return 0U;
+  const scanbyte bit = 0x80U >> (x & 7);
+  unsigned n = 0U;
+  for (int i = getBitCount() - 1; i >= 0; --i)
+    n = (n << 1) | ((*slices[i].bits(x, y) & bit) != 0 ? 1U : 0U);
+  return n;
+}
+
+} // namespace raster
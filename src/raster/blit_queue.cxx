@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file blit_queue.cxx
+/// \brief Asynchronous blit queue.
+/// \details This file contains the implementation of the BlitQueue class.
+
+#include "raster/blit_queue.hxx"
+
+#include <memory>
+
+namespace raster {
+
+BlitQueue::BlitQueue(unsigned workers) {
+  if (workers == 0U)
+    workers = std::thread::hardware_concurrency();
+  if (workers == 0U)
+    workers = 1U;
+  this->workers.reserve(workers);
+  while (workers--)
+    this->workers.emplace_back(&BlitQueue::work, this);
+}
+
+BlitQueue::~BlitQueue() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  readyCondition.notify_all();
+  for (std::thread &worker : workers)
+    worker.join();
+}
+
+std::future<bool> BlitQueue::submit(BitPlane &bitPlane, Work work) {
+  // Items must be copyable because std::function is; share the task.
+  // The task stores any exception thrown by the work in its future, so
+  // nothing escapes onto the worker thread.
+  auto task = std::make_shared<std::packaged_task<bool(BitPlane &)>>(std::move(work));
+  std::future<bool> future = task->get_future();
+  enqueue(bitPlane, [task, &bitPlane] { (*task)(bitPlane); });
+  return future;
+}
+
+std::future<bool> BlitQueue::bitBlt(BitPlane &bitPlane, int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc,
+                                    int xSrc, int ySrc, Rop2 rop2) {
+  return submit(bitPlane, [=, &bitPlaneSrc](BitPlane &bitPlaneDst) {
+    return bitPlaneDst.bitBlt(x, y, cx, cy, bitPlaneSrc, xSrc, ySrc, rop2);
+  });
+}
+
+std::future<bool> BlitQueue::bitBlt(BitPlane &bitPlane, int x, int y, int cx, int cy, Rop1 rop1) {
+  return submit(bitPlane, [=](BitPlane &bitPlaneDst) { return bitPlaneDst.bitBlt(x, y, cx, cy, rop1); });
+}
+
+void BlitQueue::wait() {
+  std::unique_lock<std::mutex> lock(mutex);
+  idleCondition.wait(lock, [this] { return pending == 0U; });
+}
+
+// BlitQueue::enqueue(bitPlane, run, then)
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// A plane has a strand in the map while it has work queued or running.
+// Only a newly-created strand goes to the ready queue; otherwise the
+// strand is either already waiting there or running on a worker, and
+// the worker re-queues it when its current item completes.
+
+void BlitQueue::enqueue(BitPlane &bitPlane, std::function<void()> run, std::function<void()> then) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto [it, inserted] = strands.try_emplace(&bitPlane);
+    it->second.push_back({std::move(run), std::move(then)});
+    ++pending;
+    if (!inserted)
+      return;
+    ready.push_back(&bitPlane);
+  }
+  readyCondition.notify_one();
+}
+
+void BlitQueue::work() {
+  std::unique_lock<std::mutex> lock(mutex);
+  for (;;) {
+    readyCondition.wait(lock, [this] { return stopping || !ready.empty(); });
+    if (ready.empty())
+      return;
+    const BitPlane *key = ready.front();
+    ready.pop_front();
+    Strand &strand = strands[key];
+    Item item = std::move(strand.front());
+    strand.pop_front();
+    lock.unlock();
+    item.run();
+    lock.lock();
+    if (strands[key].empty())
+      strands.erase(key);
+    else {
+      ready.push_back(key);
+      readyCondition.notify_one();
+    }
+    // Count the item done before running its continuation: a resumed
+    // coroutine may wait() for the queue, and would otherwise wait for
+    // itself.
+    if (--pending == 0U)
+      idleCondition.notify_all();
+    if (item.then) {
+      lock.unlock();
+      item.then();
+      lock.lock();
+    }
+  }
+}
+
+} // namespace raster
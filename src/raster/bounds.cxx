@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file bounds.cxx
+/// \brief Content bounding boxes and trimming.
+/// \details This file contains the row and column searches behind boundingBox().
+
+#include "raster/bounds.hxx"
+#include "raster/scan.hxx"
+
+#include <algorithm> // for std::min()
+#include <bit>       // for std::countl_zero(), std::countr_zero()
+#include <vector>
+
+namespace raster {
+
+namespace {
+
+// Bits beyond the width in the last scan byte of a scan line may hold
+// anything, so every test masks them out.  Searching for clear pixels
+// inverts the scan bytes first; the mask then discards the inverted
+// padding.
+
+bool anyInScan(const scanbyte *scan, std::size_t scanByteCount, scanbyte lastMask, scanbyte invert) {
+  const std::size_t wholeByteCount = scanByteCount - 1U;
+  const scanword invertWord = invert != 0U ? ~scanword(0U) : scanword(0U);
+  bool any = false;
+  forEachScan(wholeByteCount, [&](std::size_t offset, auto unit) {
+    using Unit = decltype(unit);
+    if constexpr (sizeof(Unit) == sizeof(scanword))
+      any = any || (loadScanWord(scan + offset) ^ invertWord) != 0U;
+    else
+      any = any || (scan[offset] ^ invert) != 0U;
+  });
+  return any || ((scan[wholeByteCount] ^ invert) & lastMask) != 0U;
+}
+
+} // namespace
+
+//**********************************************************************
+//                                                           boundingBox
+//**********************************************************************
+//
+//**    Synopsis
+//
+//      Rect boundingBox(bitPlane, set)
+//
+//**    Description
+//
+//      Searching runs in two stages.  First, rows: scan lines from the
+//      top down until one holds content, then from the bottom up.  Most
+//      margins are zero, so wide scan word tests rule out blank scan
+//      lines quickly and the search stops at the first content.  Second,
+//      columns: OR-reduce the scan lines between top and bottom into one
+//      accumulated scan line, whose first and last set bits give the left
+//      and right edges.  Counting leading zeros of the leftmost non-zero
+//      scan word, and trailing zeros of the rightmost, finds the edges
+//      without visiting individual pixels.
+//
+//**********************************************************************
+
+Rect boundingBox(const BitPlane &bitPlane, bool set) {
+  const int cx = bitPlane.getWidth();
+  const int cy = bitPlane.getHeight();
+  if (cx <= 0 || cy <= 0)
+    return {};
+  const std::size_t scanByteCount = (static_cast<std::size_t>(cx) + 7U) >> 3;
+  const scanbyte lastMask = 0xffU << (7 - ((cx - 1) & 7));
+  const scanbyte invert = set ? 0x00U : 0xffU;
+
+  // Set pixels can only lie in scan lines that the occupancy summary,
+  // if any, shows occupied.
+  const auto hasContent = [&](int y) {
+    return (!set || bitPlane.isRowOccupied(y)) && anyInScan(bitPlane.bits(0, y), scanByteCount, lastMask, invert);
+  };
+  int top = set ? bitPlane.nextOccupiedRow(0) : 0;
+  while (top < cy && !hasContent(top))
+    top = set ? bitPlane.nextOccupiedRow(top + 1) : top + 1;
+  if (top == cy)
+    return {};
+  int bottom = cy - 1;
+  while (!hasContent(bottom))
+    --bottom;
+
+  std::vector<scanbyte> acc(scanByteCount, 0U);
+  const scanword invertWord = set ? scanword(0U) : ~scanword(0U);
+  for (int y = top; y <= bottom; ++y) {
+    if (set && !bitPlane.isRowOccupied(y))
+      continue;
+    const scanbyte *scan = bitPlane.bits(0, y);
+    forEachScan(scanByteCount, [&](std::size_t offset, auto unit) {
+      using Unit = decltype(unit);
+      if constexpr (sizeof(Unit) == sizeof(scanword))
+        storeScanWord(acc.data() + offset, loadScanWord(acc.data() + offset) | (loadScanWord(scan + offset) ^ invertWord));
+      else
+        acc[offset] |= scan[offset] ^ invert;
+    });
+  }
+  acc[scanByteCount - 1U] &= lastMask;
+
+  // The accumulated scan line has at least one set bit because scan line
+  // top has content.
+  int left = 0;
+  for (std::size_t offset = 0U; offset < scanByteCount; offset += sizeof(scanword)) {
+    const std::size_t count = std::min(scanByteCount - offset, sizeof(scanword));
+    const scanword w = loadScanOrder(acc.data() + offset, count);
+    if (w != 0U) {
+      left = static_cast<int>(offset * 8U) + std::countl_zero(w);
+      break;
+    }
+  }
+  int right = 0;
+  for (std::size_t end = scanByteCount; end > 0U;) {
+    const std::size_t count = std::min(end, sizeof(scanword));
+    end -= count;
+    const scanword w = loadScanOrder(acc.data() + end, count);
+    if (w != 0U) {
+      // Short loads fill the least-significant bytes with zeros.
+      const int padding = static_cast<int>((sizeof(scanword) - count) * 8U);
+      right = static_cast<int>((end + count) * 8U) - 1 - (std::countr_zero(w) - padding);
+      break;
+    }
+  }
+  return {left, top, right - left + 1, bottom - top + 1};
+}
+
+BitPlane trim(BitPlane &bitPlane, bool set) {
+  const Rect box = boundingBox(bitPlane, set);
+  if (box.empty())
+    return {};
+  return bitPlane.view(box.x, box.y, box.cx, box.cy);
+}
+
+} // namespace raster
@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file dedup_plane.cxx
+/// \brief Tiled planes storing identical tiles once.
+/// \details This file contains the content-addressed tile store and the copy-on-write tile blits.
+
+#include "raster/dedup_plane.hxx"
+
+#include <algorithm> // for std::max(), std::fill_n()
+#include <cstring>   // for memcpy()
+#include <unordered_set>
+
+namespace raster {
+
+namespace {
+
+// hashTile(bits)
+// ~~~~~~~~ ~~~~~
+// Tiles hold a whole number of 64-bit words: eight-pixel multiples of
+// tile size make eight-byte multiples of scan bytes.  The hash mixes
+// one word at a time with a multiply and a shift, enough to spread
+// sparse tiles across the index; interning compares bits before it
+// shares, so collisions cost time, never correctness.
+
+std::uint64_t hashTile(const std::vector<scanbyte> &bits) {
+  std::uint64_t hash = bits.size();
+  for (std::size_t i = 0; i + sizeof(std::uint64_t) <= bits.size(); i += sizeof(std::uint64_t)) {
+    std::uint64_t word;
+    std::memcpy(&word, bits.data() + i, sizeof(word));
+    hash = (hash ^ word) * 0x9e3779b97f4a7c15U;
+    hash ^= hash >> 29;
+  }
+  return hash;
+}
+
+} // namespace
+
+std::shared_ptr<const TileStore::Tile> TileStore::intern(std::vector<scanbyte> bits) {
+  const std::uint64_t hash = hashTile(bits);
+  auto [it, last] = index.equal_range(hash);
+  while (it != last) {
+    if (std::shared_ptr<const Tile> tile = it->second.lock()) {
+      if (tile->bits == bits)
+        return tile;
+      ++it;
+    } else
+      it = index.erase(it);
+  }
+  auto tile = std::make_shared<const Tile>(Tile{hash, std::move(bits)});
+  index.emplace(hash, tile);
+  if (index.size() >= purgeSize)
+    purge();
+  return tile;
+}
+
+std::size_t TileStore::size() const {
+  return static_cast<std::size_t>(
+      std::count_if(index.begin(), index.end(), [](const auto &entry) { return !entry.second.expired(); }));
+}
+
+// TileStore::purge()
+// ~~~~~~~~~~~~~~~~~
+// Dropped tiles leave expired entries behind.  Interning erases those
+// it meets in its own bucket; a purge sweeps the rest whenever the
+// index doubles, so the index stays proportional to the live tiles.
+
+void TileStore::purge() {
+  std::erase_if(index, [](const auto &entry) { return entry.second.expired(); });
+  purgeSize = std::max<std::size_t>(64U, index.size() * 2U);
+}
+
+bool DedupPlane::create(int cx, int cy, int tileSize) {
+  tiles.clear();
+  uniformTiles[0].reset();
+  uniformTiles[1].reset();
+  if (!grid.create(cx, cy, tileSize)) {
+    grid = TileGrid();
+    return false;
+  }
+  tiles.assign(grid.tileCount(), uniformTile(false));
+  return true;
+}
+
+//**********************************************************************
+//                                                    DedupPlane::bitBlt
+//**********************************************************************
+//
+//**    Synopsis
+//
+//      bool bitBlt(x, y, cx, cy, bitPlaneSrc, xSrc, ySrc, rop2)
+//      bool bitBlt(x, y, cx, cy, rop1)
+//
+//**    Description
+//
+//      Blits into a deduplicating plane clip to the plane then visit
+//      the tiles one at a time.  Each tile copies its shared bits, lets
+//      a bit plane over the copy do the transfer, and interns the copy.
+//      Pixels of edge tiles lying beyond the plane never change, so
+//      equal content always means equal bits.
+//
+//      Fills that cover a whole tile with zeros or ones need no copy:
+//      the tile becomes the plane's shared uniform tile.  Interning
+//      answers the tile already stored for equal bits, so a fill that
+//      changes nothing leaves every tile pointer as it was; fills answer
+//      whether any tile changed.
+//
+//**********************************************************************
+
+bool DedupPlane::bitBlt(int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc, int xSrc, int ySrc, Rop2 rop2) {
+  if (!grid.clip(x, y, cx, cy, xSrc, ySrc))
+    return false;
+  bool transferred = false;
+  grid.forEachTile(x, y, cx, cy, [&](int i, int xTile, int yTile, int x0, int y0, int cx0, int cy0) {
+    std::vector<scanbyte> bits = tiles[i]->bits;
+    BitPlane tile(grid.tileSize, grid.tileSize, bits.data());
+    if (!tile.bitBlt(x0 - xTile, y0 - yTile, cx0, cy0, bitPlaneSrc, xSrc + x0 - x, ySrc + y0 - y, rop2))
+      return;
+    tiles[i] = store->intern(std::move(bits));
+    transferred = true;
+  });
+  return transferred;
+}
+
+bool DedupPlane::bitBlt(int x, int y, int cx, int cy, Rop1 rop1) {
+  int xSrc = 0, ySrc = 0;
+  if (!grid.clip(x, y, cx, cy, xSrc, ySrc))
+    return false;
+  bool changed = false;
+  grid.forEachTile(x, y, cx, cy, [&](int i, int xTile, int yTile, int x0, int y0, int cx0, int cy0) {
+    std::shared_ptr<const TileStore::Tile> tile;
+    if (rop1 != dstInvert && cx0 == grid.tileSize && cy0 == grid.tileSize)
+      tile = uniformTile(rop1 == whiteness);
+    else {
+      std::vector<scanbyte> bits = tiles[i]->bits;
+      BitPlane(grid.tileSize, grid.tileSize, bits.data()).bitBlt(x0 - xTile, y0 - yTile, cx0, cy0, rop1);
+      tile = store->intern(std::move(bits));
+    }
+    changed = changed || tile != tiles[i];
+    tiles[i] = std::move(tile);
+  });
+  return changed;
+}
+
+// DedupPlane::render(bitPlaneDst, x, y, cx, cy, xSrc, ySrc, rop2)
+// ~~~~~~~~~~~~~~~~~~ ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Rendering clips the source rectangle to this plane, moving the
+// destination origin with it, then blits each tile it covers through
+// a read-only bit plane over the tile's shared bits.
+
+bool DedupPlane::render(BitPlane &bitPlaneDst, int x, int y, int cx, int cy, int xSrc, int ySrc, Rop2 rop2) const {
+  if (!grid.clip(xSrc, ySrc, cx, cy, x, y))
+    return false;
+  bool transferred = false;
+  grid.forEachTile(xSrc, ySrc, cx, cy, [&](int i, int xTile, int yTile, int x0, int y0, int cx0, int cy0) {
+    const BitPlane tile(grid.tileSize, grid.tileSize, const_cast<scanbyte *>(tiles[i]->bits.data()));
+    if (bitPlaneDst.bitBlt(x + x0 - xSrc, y + y0 - ySrc, cx0, cy0, tile, x0 - xTile, y0 - yTile, rop2))
+      transferred = true;
+  });
+  return transferred;
+}
+
+std::size_t DedupPlane::uniqueTileCount() const {
+  std::unordered_set<const TileStore::Tile *> unique;
+  for (const auto &tile : tiles)
+    unique.insert(tile.get());
+  return unique.size();
+}
+
+std::shared_ptr<const TileStore::Tile> DedupPlane::uniformTile(bool set) {
+  std::shared_ptr<const TileStore::Tile> &tile = uniformTiles[set ? 1 : 0];
+  if (tile == nullptr) {
+    std::vector<scanbyte> bits(grid.tileStoreBytes(), 0x00U);
+    std::fill_n(bits.begin(), grid.tileScanBytes(), set ? 0xffU : 0x00U);
+    tile = store->intern(std::move(bits));
+  }
+  return tile;
+}
+
+} // namespace raster
@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file diff.cxx
+/// \brief Frame differences as dirty rectangles.
+/// \details This file contains the frame comparison and the coalescing of dirty cells.
+
+#include "raster/diff.hxx"
+#include "raster/scan.hxx"
+
+#include <algorithm> // for std::min()
+#include <bit>       // for std::countl_zero()
+#include <cstring>   // for memset()
+
+namespace raster {
+
+// coalesce(cells, columns, cx, cy, grain, rects)
+// ~~~~~~~~ ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Each row of cells yields runs of dirty cells.  A run whose columns
+// match a rectangle ending at the previous row extends that rectangle
+// downwards; any other run opens a new rectangle.  Rectangles open in
+// the previous row, and sorted by column, pair up with runs by a merge.
+
+void coalesce(std::span<const std::uint8_t> cells, int columns, int cx, int cy, Grain grain, std::vector<Rect> &rects) {
+  if (columns <= 0)
+    return;
+  const int rows = static_cast<int>(cells.size()) / columns;
+  std::vector<std::size_t> open, next;
+  for (int row = 0; row < rows; ++row) {
+    const std::uint8_t *cell = cells.data() + static_cast<std::ptrdiff_t>(row) * columns;
+    const int y = row * grain.cy;
+    const int yMax = std::min(y + grain.cy, cy);
+    next.clear();
+    std::size_t o = 0;
+    for (int column = 0; column < columns;) {
+      if (cell[column] == 0U) {
+        ++column;
+        continue;
+      }
+      const int column0 = column;
+      while (column < columns && cell[column] != 0U)
+        ++column;
+      const int x = column0 * grain.cx;
+      const int xMax = std::min(column * grain.cx, cx);
+      while (o < open.size() && rects[open[o]].x < x)
+        ++o;
+      if (o < open.size() && rects[open[o]].x == x && rects[open[o]].cx == xMax - x) {
+        rects[open[o]].cy = yMax - rects[open[o]].y;
+        next.push_back(open[o++]);
+      } else {
+        next.push_back(rects.size());
+        rects.push_back({x, y, xMax - x, yMax - y});
+      }
+    }
+    open.swap(next);
+  }
+}
+
+//**********************************************************************
+//                                                             frameDiff
+//**********************************************************************
+//
+//**    Synopsis
+//
+//      bool frameDiff(previous, current, dirty, grain, delta)
+//
+//**    Description
+//
+//      Frame difference XORs the two frames a scan word at a time.  Zero
+//      words, the common case for a mostly-static display, cost one test
+//      each.  Within a non-zero word, counting leading zeros finds the
+//      first changed pixel; its cell becomes dirty and the search skips
+//      to the next cell, so cost tracks the number of dirty cells rather
+//      than the number of changed pixels.  Bits beyond the width never
+//      count.  Scan lines and scan words empty in both frames, according
+//      to their occupancy summaries, compare equal without loading.  The
+//      optional delta plane receives the XOR of every scan line as it
+//      goes by, then records the write like any blit.
+//
+//**********************************************************************
+
+bool frameDiff(const BitPlane &previous, const BitPlane &current, std::vector<Rect> &dirty, Grain grain,
+               BitPlane *delta) {
+  dirty.clear();
+  const int cx = current.getWidth();
+  const int cy = current.getHeight();
+  if (previous.getWidth() != cx || previous.getHeight() != cy)
+    return false;
+  if (grain.cx <= 0)
+    grain.cx = Grain{}.cx;
+  if (grain.cy <= 0)
+    grain.cy = Grain{}.cy;
+  if (delta != nullptr && (delta->getWidth() != cx || delta->getHeight() != cy) && !delta->create(cx, cy))
+    return false;
+  if (cx <= 0 || cy <= 0)
+    return true;
+
+  const std::size_t scanByteCount = (static_cast<std::size_t>(cx) + 7U) >> 3;
+  const int columns = (cx + grain.cx - 1) / grain.cx;
+  const int rows = (cy + grain.cy - 1) / grain.cy;
+  std::vector<std::uint8_t> cells(static_cast<std::size_t>(columns) * rows, 0U);
+  for (int y = 0; y < cy; ++y) {
+    const scanbyte *p = previous.bits(0, y);
+    const scanbyte *c = current.bits(0, y);
+    scanbyte *d = delta != nullptr ? delta->bits(0, y) : nullptr;
+    std::uint8_t *cell = cells.data() + static_cast<std::ptrdiff_t>(y / grain.cy) * columns;
+    if (!previous.isRowOccupied(y) && !current.isRowOccupied(y)) {
+      if (d != nullptr)
+        (void)memset(d, 0, scanByteCount);
+      continue;
+    }
+    for (std::size_t offset = 0U; offset < scanByteCount; offset += sizeof(scanword)) {
+      const std::size_t count = std::min(scanByteCount - offset, sizeof(scanword));
+      if (!previous.isWordOccupied(y, offset) && !current.isWordOccupied(y, offset)) {
+        if (d != nullptr)
+          storeScanOrder(d + offset, 0U, count);
+        continue;
+      }
+      scanword w = loadScanOrder(p + offset, count) ^ loadScanOrder(c + offset, count);
+      if (d != nullptr)
+        storeScanOrder(d + offset, w, count);
+      const int x0 = static_cast<int>(offset * 8U);
+      while (w != 0U) {
+        const int x = x0 + std::countl_zero(w);
+        if (x >= cx)
+          break;
+        const int column = x / grain.cx;
+        cell[column] = 1U;
+        const int skip = (column + 1) * grain.cx - x0;
+        if (skip >= 64)
+          break;
+        w &= ~scanword(0U) >> skip;
+      }
+    }
+  }
+  if (delta != nullptr)
+    delta->touch(0, 0, cx, cy);
+  coalesce(cells, columns, cx, cy, grain, dirty);
+  return true;
+}
+
+} // namespace raster
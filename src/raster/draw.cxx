@@ -0,0 +1,544 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file draw.cxx
+/// \brief Lines, spans, rectangles, ellipses and thick strokes.
+/// \details This file contains the span writer and the shape primitives built on it.
+
+#include "raster/draw.hxx"
+#include "raster/scan.hxx"
+
+#include <algorithm> // for std::min(), std::max(), std::swap()
+#include <cmath>     // for std::atan2(), std::ceil(), std::floor(), std::fmod(), std::hypot(), std::sqrt()
+#include <cstdint>
+#include <cstdlib> // for std::abs()
+#include <vector>
+
+namespace raster {
+
+namespace {
+
+// Ink reduces to one of four unary operations on the masked bits of a
+// scan byte or scan word.  Where a clip mask applies, its bits narrow
+// the mask.
+template <typename Word> void applyInk(scanbyte *p, Word mask, Rop2 ink, const scanbyte *clip) {
+  if (clip != nullptr)
+    mask &= loadScan<Word>(clip);
+  Word d = loadScan<Word>(p);
+  switch (ink) {
+  case rop0:
+    d &= static_cast<Word>(~mask);
+    break;
+  case ropDn:
+    d ^= mask;
+    break;
+  case rop1:
+    d |= mask;
+    break;
+  default:
+    return;
+  }
+  storeScan<Word>(p, d);
+}
+
+// Radii clamp so that the ellipse arithmetic fits 64 bits.
+constexpr int maxRadius = 16383;
+
+//**********************************************************************
+//                                                           halfWidths
+//**********************************************************************
+//
+//**    Synopsis
+//
+//      std::vector<int> halfWidths(rx, ry)
+//
+//**    Description
+//
+//      Answers, for each scan line dy from 0 to ry, the greatest x such
+//      that pixel x, dy lies within the ellipse with radii rx, ry.  The
+//      midpoint test puts the boundary half a pixel beyond the radii,
+//      where 4x^2(2ry + 1)^2 + 4dy^2(2rx + 1)^2 meets (2rx + 1)^2(2ry +
+//      1)^2; for a circle, that is the familiar x^2 + y^2 <= r^2 + r.
+//      Moving up from the widest scan line, the half width only ever
+//      shrinks, so all the scan lines together cost O(rx + ry) integer
+//      steps.
+//
+//**********************************************************************
+
+std::vector<int> halfWidths(int rx, int ry) {
+  const std::int64_t a = 2 * static_cast<std::int64_t>(rx) + 1;
+  const std::int64_t b = 2 * static_cast<std::int64_t>(ry) + 1;
+  const std::int64_t limit = a * a * b * b;
+  std::vector<int> xs(ry + 1);
+  std::int64_t x = rx;
+  for (std::int64_t dy = 0; dy <= ry; ++dy) {
+    while (x > 0 && 4 * x * x * b * b + 4 * dy * dy * a * a > limit)
+      --x;
+    xs[dy] = static_cast<int>(x);
+  }
+  return xs;
+}
+
+// Visits the spans of an ellipse's one-pixel outline, each pixel once.
+// Scan line dy of the outline runs from just beyond the next scan
+// line's half width out to its own, so that the outline stays
+// connected where it runs steeply.
+template <typename Visit> void forEachOutlineSpan(int x, int y, const std::vector<int> &xs, Visit visit) {
+  const int ry = static_cast<int>(xs.size()) - 1;
+  for (int dy = 0; dy <= ry; ++dy) {
+    const int hi = xs[dy];
+    const int lo = dy < ry ? std::min(xs[dy + 1] + 1, hi) : 0;
+    for (const int row : {y + dy, y - dy}) {
+      if (lo == 0)
+        visit(x - hi, x + hi + 1, row);
+      else {
+        visit(x - hi, x - lo + 1, row);
+        visit(x + lo, x + hi + 1, row);
+      }
+      if (dy == 0)
+        break;
+    }
+  }
+}
+
+// Pixel-centre span of a closed interval of x, or an empty span.
+struct Interval {
+  double x0 = 1;
+  double x1 = 0;
+  bool empty() const { return x1 < x0; }
+  void extend(double x) {
+    if (empty())
+      x0 = x1 = x;
+    else {
+      x0 = std::min(x0, x);
+      x1 = std::max(x1, x);
+    }
+  }
+  void extend(const Interval &interval) {
+    if (!interval.empty()) {
+      extend(interval.x0);
+      extend(interval.x1);
+    }
+  }
+};
+
+// Interval of scan line y within a convex polygon.
+Interval convexInterval(const double (*corners)[2], int n, double y) {
+  Interval interval;
+  for (int i = 0; i < n; ++i) {
+    const double *a = corners[i];
+    const double *b = corners[(i + 1) % n];
+    if (y < std::min(a[1], b[1]) || y > std::max(a[1], b[1]))
+      continue;
+    if (a[1] == b[1]) {
+      interval.extend(a[0]);
+      interval.extend(b[0]);
+    } else
+      interval.extend(a[0] + (y - a[1]) * (b[0] - a[0]) / (b[1] - a[1]));
+  }
+  return interval;
+}
+
+// Interval of scan line y within a disc.
+Interval discInterval(double x, double y, double r, double yRow) {
+  Interval interval;
+  const double dy = yRow - y;
+  if (dy * dy <= r * r) {
+    const double half = std::sqrt(r * r - dy * dy);
+    interval.x0 = x - half;
+    interval.x1 = x + half;
+  }
+  return interval;
+}
+
+} // namespace
+
+SpanWriter::SpanWriter(BitPlane &bitPlane, Rop2 rop2)
+    : bitPlane(bitPlane), clipMask(bitPlane.getClipMask()), ink(unaryRop(rop2, 1)), cx(bitPlane.getWidth()),
+      cy(bitPlane.getHeight()) {
+  // Pixels beyond the clip mask never change.
+  if (clipMask != nullptr) {
+    cx = std::min(cx, clipMask->getWidth());
+    cy = std::min(cy, clipMask->getHeight());
+  }
+  if (ink == ropD)
+    cx = cy = 0;
+  left = cx;
+  top = cy;
+  right = bottom = 0;
+}
+
+//**********************************************************************
+//                                                      SpanWriter::span
+//**********************************************************************
+//
+//**    Synopsis
+//
+//      bool span(x0, x1, y)
+//
+//**    Description
+//
+//      A span covers scan bytes x0 >> 3 through (x1 - 1) >> 3.  The
+//      first and last take edge masks, or one merged mask when they are
+//      the same scan byte.  Whole scan words fill the scan bytes between
+//      eight at a time, then single scan bytes fill what remains.
+//
+//**********************************************************************
+
+bool SpanWriter::span(int x0, int x1, int y) {
+  x0 = std::max(x0, 0);
+  x1 = std::min(x1, cx);
+  if (x0 >= x1 || y < 0 || y >= cy)
+    return false;
+  scanbyte *scan = bitPlane.bits(0, y);
+  const scanbyte *clip = clipMask != nullptr ? clipMask->bits(0, y) : nullptr;
+  const auto at = [clip](int offset) { return clip != nullptr ? clip + offset : nullptr; };
+  const int first = x0 >> 3;
+  const int last = (x1 - 1) >> 3;
+  const scanbyte orgMask = 0xffU >> (x0 & 7);
+  const scanbyte extMask = 0xffU << (7 - ((x1 - 1) & 7));
+  if (first == last)
+    applyInk<scanbyte>(scan + first, orgMask & extMask, ink, at(first));
+  else {
+    applyInk<scanbyte>(scan + first, orgMask, ink, at(first));
+    int offset = first + 1;
+    for (; offset + static_cast<int>(sizeof(scanword)) <= last; offset += sizeof(scanword))
+      applyInk<scanword>(scan + offset, ~scanword(0U), ink, at(offset));
+    for (; offset < last; ++offset)
+      applyInk<scanbyte>(scan + offset, 0xffU, ink, at(offset));
+    applyInk<scanbyte>(scan + last, extMask, ink, at(last));
+  }
+  left = std::min(left, x0);
+  right = std::max(right, x1);
+  top = std::min(top, y);
+  bottom = std::max(bottom, y + 1);
+  return true;
+}
+
+// SpanWriter::column(x, y0, y1)
+// ~~~~~~~~~~~~~~~~~~ ~~~~~~~~~~
+// Every pixel of a column shares one scan byte offset and one bit mask;
+// only the scan line changes.
+
+bool SpanWriter::column(int x, int y0, int y1) {
+  y0 = std::max(y0, 0);
+  y1 = std::min(y1, cy);
+  if (x < 0 || x >= cx || y0 >= y1)
+    return false;
+  const auto mask = static_cast<scanbyte>(0x80U >> (x & 7));
+  for (int y = y0; y < y1; ++y)
+    applyInk<scanbyte>(bitPlane.bits(x, y), mask, ink, clipMask != nullptr ? clipMask->bits(x, y) : nullptr);
+  left = std::min(left, x);
+  right = std::max(right, x + 1);
+  top = std::min(top, y0);
+  bottom = std::max(bottom, y1);
+  return true;
+}
+
+void SpanWriter::finish() {
+  if (left < right)
+    bitPlane.touch(left, top, right - left, bottom - top);
+  left = cx;
+  top = cy;
+  right = bottom = 0;
+}
+
+bool drawSpan(BitPlane &bitPlane, int x, int y, int cx, Rop2 rop2) {
+  return SpanWriter(bitPlane, rop2).span(x, x + cx, y);
+}
+
+bool drawVLine(BitPlane &bitPlane, int x, int y, int cy, Rop2 rop2) {
+  return SpanWriter(bitPlane, rop2).column(x, y, y + cy);
+}
+
+//**********************************************************************
+//                                                              drawLine
+//**********************************************************************
+//
+//**    Synopsis
+//
+//      bool drawLine(bitPlane, x0, y0, x1, y1, rop2)
+//
+//**    Description
+//
+//      Bresenham's line steps along the major axis, the axis of greater
+//      extent D, one pixel at a time; the minor axis, of extent m, steps
+//      where the accumulated error crosses one half.  The pixel at major
+//      step k therefore lies at minor step floor((2km + D) / 2D).  The
+//      closed form lets clipping skip straight to the first scan line
+//      within the plane instead of stepping there.
+//
+//      Lines along x draw one span per scan line.  Scan line j of the
+//      line, counting from its start, spans the major steps from k(j) up
+//      to k(j + 1), where k(j) = ceil((2j - 1)D / 2m) is the first step
+//      reaching minor step j.  Lines along y draw one pixel per scan
+//      line.  Lines always run from the end with the lesser major co-
+//      ordinate, so that both directions draw the same pixels.
+//
+//**********************************************************************
+
+bool drawLine(BitPlane &bitPlane, int x0, int y0, int x1, int y1, Rop2 rop2) {
+  SpanWriter writer(bitPlane, rop2);
+  const int cy = bitPlane.getHeight();
+  const bool alongX = std::abs(static_cast<std::int64_t>(x1) - x0) >= std::abs(static_cast<std::int64_t>(y1) - y0);
+  if (alongX ? x1 < x0 : y1 < y0) {
+    std::swap(x0, x1);
+    std::swap(y0, y1);
+  }
+  const std::int64_t dx = static_cast<std::int64_t>(x1) - x0;
+  const std::int64_t dy = static_cast<std::int64_t>(y1) - y0;
+  bool drew = false;
+  if (alongX) {
+    const std::int64_t d = dx;
+    const std::int64_t m = std::abs(dy);
+    const int sy = dy < 0 ? -1 : 1;
+    // First major step reaching minor step j.
+    const auto k = [d, m](std::int64_t j) -> std::int64_t {
+      if (j <= 0)
+        return 0;
+      if (j > m)
+        return d + 1;
+      return ((2 * j - 1) * d + 2 * m - 1) / (2 * m);
+    };
+    std::int64_t j0 = sy > 0 ? -static_cast<std::int64_t>(y0) : y0 - static_cast<std::int64_t>(cy - 1);
+    std::int64_t j1 = sy > 0 ? static_cast<std::int64_t>(cy - 1) - y0 : y0;
+    j0 = std::max<std::int64_t>(j0, 0);
+    j1 = std::min(j1, m);
+    for (std::int64_t j = j0; j <= j1; ++j) {
+      const std::int64_t xa = std::max<std::int64_t>(x0 + k(j), 0);
+      const std::int64_t xb = std::min<std::int64_t>(x0 + k(j + 1), bitPlane.getWidth());
+      if (xa < xb)
+        drew = writer.span(static_cast<int>(xa), static_cast<int>(xb), static_cast<int>(y0 + sy * j)) || drew;
+    }
+  } else {
+    const std::int64_t d = dy;
+    const std::int64_t m = std::abs(dx);
+    const int sx = dx < 0 ? -1 : 1;
+    const std::int64_t k0 = std::max<std::int64_t>(0, -static_cast<std::int64_t>(y0));
+    const std::int64_t k1 = std::min<std::int64_t>(d, static_cast<std::int64_t>(cy - 1) - y0);
+    for (std::int64_t k = k0; k <= k1; ++k) {
+      const std::int64_t x = x0 + sx * ((2 * k * m + d) / (2 * d));
+      if (0 <= x && x < bitPlane.getWidth())
+        drew = writer.span(static_cast<int>(x), static_cast<int>(x) + 1, static_cast<int>(y0 + k)) || drew;
+    }
+  }
+  return drew;
+}
+
+bool drawRect(BitPlane &bitPlane, int x, int y, int cx, int cy, Rop2 rop2) {
+  if (cx <= 0 || cy <= 0)
+    return false;
+  SpanWriter writer(bitPlane, rop2);
+  bool drew = writer.span(x, x + cx, y);
+  if (cy > 1)
+    drew = writer.span(x, x + cx, y + cy - 1) || drew;
+  if (cy > 2) {
+    drew = writer.column(x, y + 1, y + cy - 1) || drew;
+    if (cx > 1)
+      drew = writer.column(x + cx - 1, y + 1, y + cy - 1) || drew;
+  }
+  return drew;
+}
+
+bool fillRect(BitPlane &bitPlane, int x, int y, int cx, int cy, Rop2 rop2) {
+  if (cx <= 0 || cy <= 0)
+    return false;
+  SpanWriter writer(bitPlane, rop2);
+  bool drew = false;
+  for (int row = std::max(y, 0); row < y + cy && row < bitPlane.getHeight(); ++row)
+    drew = writer.span(x, x + cx, row) || drew;
+  return drew;
+}
+
+bool drawEllipse(BitPlane &bitPlane, int x, int y, int rx, int ry, Rop2 rop2) {
+  if (rx < 0 || ry < 0)
+    return false;
+  SpanWriter writer(bitPlane, rop2);
+  bool drew = false;
+  forEachOutlineSpan(x, y, halfWidths(std::min(rx, maxRadius), std::min(ry, maxRadius)),
+                     [&](int x0, int x1, int row) { drew = writer.span(x0, x1, row) || drew; });
+  return drew;
+}
+
+bool fillEllipse(BitPlane &bitPlane, int x, int y, int rx, int ry, Rop2 rop2) {
+  if (rx < 0 || ry < 0)
+    return false;
+  const std::vector<int> xs = halfWidths(std::min(rx, maxRadius), std::min(ry, maxRadius));
+  SpanWriter writer(bitPlane, rop2);
+  bool drew = false;
+  for (int dy = 0; dy < static_cast<int>(xs.size()); ++dy) {
+    drew = writer.span(x - xs[dy], x + xs[dy] + 1, y + dy) || drew;
+    if (dy != 0)
+      drew = writer.span(x - xs[dy], x + xs[dy] + 1, y - dy) || drew;
+  }
+  return drew;
+}
+
+// strokeEllipse(bitPlane, x, y, rx, ry, width, rop2)
+// ~~~~~~~~~~~~~ ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// A thick outline is the ring between an outer ellipse, half the width
+// beyond the radii, and an inner ellipse one width within the outer.
+// Each scan line of the ring is one span, or two where it crosses the
+// inner ellipse.
+
+bool strokeEllipse(BitPlane &bitPlane, int x, int y, int rx, int ry, int width, Rop2 rop2) {
+  if (rx < 0 || ry < 0 || width <= 0)
+    return false;
+  if (width == 1)
+    return drawEllipse(bitPlane, x, y, rx, ry, rop2);
+  rx = std::min(rx, maxRadius - width / 2);
+  ry = std::min(ry, maxRadius - width / 2);
+  const int rxOuter = rx + width / 2;
+  const int ryOuter = ry + width / 2;
+  const std::vector<int> outer = halfWidths(rxOuter, ryOuter);
+  const std::vector<int> inner =
+      rxOuter >= width && ryOuter >= width ? halfWidths(rxOuter - width, ryOuter - width) : std::vector<int>();
+  SpanWriter writer(bitPlane, rop2);
+  bool drew = false;
+  for (int dy = 0; dy <= ryOuter; ++dy) {
+    const int hi = outer[dy];
+    for (const int row : {y + dy, y - dy}) {
+      if (dy < static_cast<int>(inner.size())) {
+        drew = writer.span(x - hi, x - inner[dy], row) || drew;
+        drew = writer.span(x + inner[dy] + 1, x + hi + 1, row) || drew;
+      } else
+        drew = writer.span(x - hi, x + hi + 1, row) || drew;
+      if (dy == 0)
+        break;
+    }
+  }
+  return drew;
+}
+
+// drawArc(bitPlane, x, y, rx, ry, startAngle, sweepAngle, rop2)
+// ~~~~~~~ ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// An arc draws those pixels of the outline whose parametric angles lie
+// within the sweep, merging neighbouring pixels back into spans.  Each
+// pixel's angle costs an arctangent, so spans clip to the plane first:
+// a large arc over a small plane only pays for the pixels it can draw.
+
+bool drawArc(BitPlane &bitPlane, int x, int y, int rx, int ry, double startAngle, double sweepAngle, Rop2 rop2) {
+  if (rx < 0 || ry < 0)
+    return false;
+  if (std::abs(sweepAngle) >= 360)
+    return drawEllipse(bitPlane, x, y, rx, ry, rop2);
+  if (sweepAngle < 0) {
+    startAngle += sweepAngle;
+    sweepAngle = -sweepAngle;
+  }
+  rx = std::min(rx, maxRadius);
+  ry = std::min(ry, maxRadius);
+  const double degrees = 180 / 3.14159265358979323846;
+  const auto within = [=](int dx, int dy) {
+    const double angle =
+        std::atan2(-static_cast<double>(dy) * std::max(rx, 1), static_cast<double>(dx) * std::max(ry, 1));
+    double a = std::fmod(angle * degrees - startAngle, 360);
+    if (a < 0)
+      a += 360;
+    return a <= sweepAngle;
+  };
+  SpanWriter writer(bitPlane, rop2);
+  bool drew = false;
+  forEachOutlineSpan(x, y, halfWidths(rx, ry), [&](int x0, int x1, int row) {
+    if (row < 0 || row >= bitPlane.getHeight())
+      return;
+    x0 = std::max(x0, 0);
+    x1 = std::min(x1, bitPlane.getWidth());
+    int xRun = x0;
+    for (int xPixel = x0; xPixel <= x1; ++xPixel)
+      if (xPixel == x1 || !within(xPixel - x, row - y)) {
+        if (xRun < xPixel)
+          drew = writer.span(xRun, xPixel, row) || drew;
+        xRun = xPixel + 1;
+      }
+  });
+  return drew;
+}
+
+//**********************************************************************
+//                                                            strokeLine
+//**********************************************************************
+//
+//**    Synopsis
+//
+//      bool strokeLine(bitPlane, x0, y0, x1, y1, width, lineCap, rop2)
+//
+//**    Description
+//
+//      A thick line with butt or square caps is a rectangle along the
+//      line, a convex quadrilateral; round caps add a disc at either
+//      end, and the union remains convex.  Every scan line therefore
+//      crosses the stroke in one interval, found by intersecting the
+//      scan line with the quadrilateral's edges and with the discs.
+//      The interval becomes one span of the pixels whose centres lie
+//      within it.  A line of no length draws nothing with butt caps, a
+//      square with square caps and a disc with round caps.
+//
+//**********************************************************************
+
+bool strokeLine(BitPlane &bitPlane, int x0, int y0, int x1, int y1, int width, LineCap lineCap, Rop2 rop2) {
+  if (width <= 0)
+    return false;
+  // Work relative to the start point, so that moving a stroke by whole
+  // pixels moves its pixels exactly; banded rendering relies on it.
+  const double half = width / 2.0;
+  const double dx = static_cast<double>(x1) - x0;
+  const double dy = static_cast<double>(y1) - y0;
+  const double length = std::hypot(dx, dy);
+  if (length == 0 && lineCap == LineCap::butt)
+    return false;
+  const double ux = length == 0 ? 1 : dx / length;
+  const double uy = length == 0 ? 0 : dy / length;
+  const double extend = lineCap == LineCap::square ? half : 0;
+  const double corners[4][2] = {
+      {-extend * ux - half * uy, -extend * uy + half * ux},
+      {dx + extend * ux - half * uy, dy + extend * uy + half * ux},
+      {dx + extend * ux + half * uy, dy + extend * uy - half * ux},
+      {-extend * ux + half * uy, -extend * uy - half * ux},
+  };
+  double top = corners[0][1];
+  double bottom = top;
+  for (const auto &corner : corners) {
+    top = std::min(top, corner[1]);
+    bottom = std::max(bottom, corner[1]);
+  }
+  if (lineCap == LineCap::round) {
+    top = std::min(top, std::min(0.0, dy) - half);
+    bottom = std::max(bottom, std::max(0.0, dy) + half);
+  }
+  SpanWriter writer(bitPlane, rop2);
+  bool drew = false;
+  const double yFirst = std::max(std::ceil(top), -static_cast<double>(y0));
+  const double yLast = std::min(std::floor(bottom), bitPlane.getHeight() - 1.0 - y0);
+  for (double y = yFirst; y <= yLast; ++y) {
+    Interval interval = length == 0 ? Interval() : convexInterval(corners, 4, y);
+    if (lineCap == LineCap::round) {
+      interval.extend(discInterval(0, 0, half, y));
+      interval.extend(discInterval(dx, dy, half, y));
+    } else if (length == 0)
+      interval = convexInterval(corners, 4, y);
+    if (interval.empty())
+      continue;
+    const double xa = std::max(std::ceil(interval.x0) + x0, -1.0);
+    const double xb = std::min(std::floor(interval.x1) + 1 + x0, bitPlane.getWidth() + 1.0);
+    if (xa < xb)
+      drew = writer.span(static_cast<int>(xa), static_cast<int>(xb), static_cast<int>(y) + y0) || drew;
+  }
+  return drew;
+}
+
+} // namespace raster
@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file execution.cxx
+/// \brief Execution policies for bit-plane operations.
+/// \details This file contains the band partitioning behind the parallel execution policies.
+
+#include "raster/execution.hxx"
+
+#include <algorithm> // for std::min()
+#include <thread>
+#include <vector>
+
+namespace raster::execution {
+
+// forEachBand(par, cy, scanBytes, band)
+// ~~~~~~~~~~~ ~~~~~~~~~~~~~~~~~~~~~~~~~
+// Bands divide the scan lines as evenly as possible; the first cy % n
+// bands take one extra line.  The calling thread runs the last band
+// rather than waiting idle for the others.
+
+void forEachBand(const parallel_policy &policy, int cy, std::size_t scanBytes, const Band &band) {
+  if (cy <= 0)
+    return;
+  std::size_t n = std::thread::hardware_concurrency();
+  if (n == 0)
+    n = 1;
+  n = std::min(n, static_cast<std::size_t>(cy));
+  const std::size_t grain = std::max<std::size_t>(policy.grain, 1U);
+  n = std::min(n, std::max<std::size_t>(scanBytes * cy / grain, 1U));
+  if (n == 1) {
+    band(0, cy);
+    return;
+  }
+  const int bandCount = static_cast<int>(n);
+  const int cyBand = cy / bandCount;
+  const int extra = cy % bandCount;
+  std::vector<std::thread> threads;
+  threads.reserve(n - 1);
+  int y = 0;
+  for (int i = 0; i < bandCount; ++i) {
+    const int cyThis = cyBand + (i < extra ? 1 : 0);
+    if (i == bandCount - 1)
+      band(y, cyThis);
+    else
+      threads.emplace_back(band, y, cyThis);
+    y += cyThis;
+  }
+  for (std::thread &thread : threads)
+    thread.join();
+}
+
+} // namespace raster::execution
@@ -0,0 +1,220 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file neighbourhood.cxx
+/// \brief 3x3 neighbourhood rules over bit planes.
+/// \details This file contains the bit-sliced neighbour counting and rule evaluation.
+
+#include "raster/neighbourhood.hxx"
+
+#include <algorithm> // for std::fill()
+#include <cstring>   // for memcpy()
+#include <vector>
+
+namespace raster {
+
+namespace {
+
+// Neighbour words
+// ~~~~~~~~~ ~~~~~
+// Each source scan line loads into scan words in scan order, the most
+// significant bit leftmost.  Three words describe every 64 pixels of a
+// scan line: centre C, the pixels themselves; west W, each pixel's left
+// neighbour; and east E, each pixel's right neighbour.  W and E are C
+// shifted by one bit with the neighbouring word's end bit carried in.
+// Bits beyond the width load as zeros; the border treatment supplies
+// the pixel left of the first and right of the last.
+
+class NeighbourScan {
+public:
+  explicit NeighbourScan(int cx) : cx(cx), c((cx + 63) / 64), w(c.size()), e(c.size()) {}
+
+  void load(const BitPlane &bitPlane, int y, Edge edge) {
+    const std::size_t scanByteCount = (static_cast<std::size_t>(cx) + 7U) >> 3;
+    const scanbyte *scan = bitPlane.bits(0, y);
+    const std::size_t n = c.size();
+    for (std::size_t j = 0; j < n; ++j) {
+      const std::size_t offset = j * sizeof(scanword);
+      const std::size_t count = scanByteCount - offset;
+      c[j] = loadScanOrder(scan + offset, count < sizeof(scanword) ? count : sizeof(scanword));
+    }
+    const int last = cx - 1;
+    const scanword lastBit = scanword(1U) << (63 - (last & 63));
+    c[n - 1] &= ~(lastBit - 1U);
+    const scanword first = c[0] >> 63;
+    const scanword final = (c[n - 1] & lastBit) != 0U ? 1U : 0U;
+    scanword beforeFirst = 0U;
+    scanword afterLast = 0U;
+    if (edge == edgeClamp) {
+      beforeFirst = first;
+      afterLast = final;
+    } else if (edge == edgeWrap) {
+      beforeFirst = final;
+      afterLast = first;
+    }
+    for (std::size_t j = 0; j < n; ++j) {
+      w[j] = (c[j] >> 1) | ((j == 0 ? beforeFirst : c[j - 1]) << 63);
+      e[j] = (c[j] << 1) | (j + 1 < n ? c[j + 1] >> 63 : 0U);
+    }
+    if (afterLast != 0U)
+      e[n - 1] |= lastBit;
+  }
+
+  void clear() {
+    std::fill(c.begin(), c.end(), scanword(0U));
+    std::fill(w.begin(), w.end(), scanword(0U));
+    std::fill(e.begin(), e.end(), scanword(0U));
+  }
+
+  int cx;
+  std::vector<scanword> c;
+  std::vector<scanword> w;
+  std::vector<scanword> e;
+};
+
+// Bit-sliced neighbour count
+// ~~~~~~~~~~ ~~~~~~~~~ ~~~~~
+// Eight neighbour words sum to a four-bit count per lane using full
+// adders (three inputs: sum is XOR, carry is majority) and half adders.
+// Units first: two full adders and a half adder reduce the eight inputs
+// to three unit bits and three twos; a further full adder leaves count
+// bit 0 and a fourth two.  The four twos sum likewise into count bits 1,
+// 2 and 3.
+
+inline void fullAdd(scanword a, scanword b, scanword c, scanword &sum, scanword &carry) {
+  const scanword ab = a ^ b;
+  sum = ab ^ c;
+  carry = (a & b) | (ab & c);
+}
+
+scanword applyRule(const NeighbourScan &up, const NeighbourScan &mid, const NeighbourScan &down, std::size_t j,
+                   NeighbourRule rule) {
+  scanword s1, c1, s2, c2;
+  fullAdd(up.w[j], up.c[j], up.e[j], s1, c1);
+  fullAdd(down.w[j], down.c[j], down.e[j], s2, c2);
+  const scanword s3 = mid.w[j] ^ mid.e[j];
+  const scanword c3 = mid.w[j] & mid.e[j];
+  scanword bit0, k1;
+  fullAdd(s1, s2, s3, bit0, k1);
+  scanword t, u;
+  fullAdd(c1, c2, c3, t, u);
+  const scanword bit1 = t ^ k1;
+  const scanword v = t & k1;
+  const scanword bit2 = u ^ v;
+  const scanword bit3 = u & v;
+
+  const scanword centre = mid.c[j];
+  scanword next = 0U;
+  for (unsigned n = 0U; n <= 8U; ++n) {
+    const bool born = (rule.birth >> n) & 1U;
+    const bool survives = (rule.survival >> n) & 1U;
+    if (!born && !survives)
+      continue;
+    const scanword eq = (n & 1U ? bit0 : ~bit0) & (n & 2U ? bit1 : ~bit1) & (n & 4U ? bit2 : ~bit2) &
+                        (n & 8U ? bit3 : ~bit3);
+    next |= eq & (born ? (survives ? ~scanword(0U) : ~centre) : centre);
+  }
+  return next;
+}
+
+template <typename Policy>
+bool neighbourhoodWith(const Policy &policy, BitPlane &bitPlane, const BitPlane &bitPlaneSrc, NeighbourRule rule,
+                       Edge edge) {
+  const int cx = bitPlane.getWidth();
+  const int cy = bitPlane.getHeight();
+  if (&bitPlane == &bitPlaneSrc || cx != bitPlaneSrc.getWidth() || cy != bitPlaneSrc.getHeight() || cx == 0 ||
+      cy == 0)
+    return false;
+  const std::size_t scanByteCount = (static_cast<std::size_t>(cx) + 7U) >> 3;
+  const scanbyte scanExtMask = 0xffU << ((8 - (cx & 7)) & 7);
+
+  // Rows beyond the top and bottom borders: none for zero edges, the
+  // border row for clamped edges, the opposite border row for wrapping.
+  auto loadRow = [&](NeighbourScan &scan, int y) {
+    if (y < 0)
+      y = edge == edgeWrap ? cy - 1 : edge == edgeClamp ? 0 : -1;
+    else if (y >= cy)
+      y = edge == edgeWrap ? 0 : edge == edgeClamp ? cy - 1 : -1;
+    if (y < 0)
+      scan.clear();
+    else
+      scan.load(bitPlaneSrc, y, edge);
+  };
+
+  execution::forEachBand(policy, cy, scanByteCount * 3U, [&](int yBand, int cyBand) {
+    NeighbourScan scans[3] = {NeighbourScan(cx), NeighbourScan(cx), NeighbourScan(cx)};
+    NeighbourScan *up = &scans[0];
+    NeighbourScan *mid = &scans[1];
+    NeighbourScan *down = &scans[2];
+    loadRow(*up, yBand - 1);
+    loadRow(*mid, yBand);
+    std::vector<scanbyte> next(mid->c.size() * sizeof(scanword));
+    for (int y = yBand; y < yBand + cyBand; ++y) {
+      loadRow(*down, y + 1);
+      for (std::size_t j = 0; j < mid->c.size(); ++j)
+        storeScanOrder(next.data() + j * sizeof(scanword), applyRule(*up, *mid, *down, j, rule));
+      scanbyte *store = bitPlane.bits(0, y);
+      const scanbyte last = store[scanByteCount - 1];
+      (void)memcpy(store, next.data(), scanByteCount);
+      store[scanByteCount - 1] = (last & ~scanExtMask) | (store[scanByteCount - 1] & scanExtMask);
+      NeighbourScan *const recycle = up;
+      up = mid;
+      mid = down;
+      down = recycle;
+    }
+    bitPlane.touch(0, yBand, cx, cyBand);
+  });
+  return true;
+}
+
+} // namespace
+
+//**********************************************************************
+//                                                         neighbourhood
+//**********************************************************************
+//
+//**    Synopsis
+//
+//      bool neighbourhood([policy,] bitPlane, bitPlaneSrc, rule, edge)
+//
+//**    Description
+//
+//      Neighbourhood computes one generation: for every source pixel it
+//      counts the set pixels among its eight neighbours, then looks up
+//      the destination pixel in the rule: the birth mask for clear
+//      pixels, the survival mask for set pixels.  Three source scan lines
+//      stay loaded at any time; each new destination scan line loads one
+//      more and recycles the oldest.  Parallel bands each load their own
+//      border lines, so no band depends on another.
+//
+//**********************************************************************
+
+bool neighbourhood(BitPlane &bitPlane, const BitPlane &bitPlaneSrc, NeighbourRule rule, Edge edge) {
+  return neighbourhoodWith(execution::seq, bitPlane, bitPlaneSrc, rule, edge);
+}
+
+bool neighbourhood(const execution::sequenced_policy &policy, BitPlane &bitPlane, const BitPlane &bitPlaneSrc,
+                   NeighbourRule rule, Edge edge) {
+  return neighbourhoodWith(policy, bitPlane, bitPlaneSrc, rule, edge);
+}
+
+bool neighbourhood(const execution::parallel_policy &policy, BitPlane &bitPlane, const BitPlane &bitPlaneSrc,
+                   NeighbourRule rule, Edge edge) {
+  return neighbourhoodWith(policy, bitPlane, bitPlaneSrc, rule, edge);
+}
+
+} // namespace raster
@@ -0,0 +1,282 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file paged_plane.cxx
+/// \brief Tiled planes paged to a backing file.
+/// \details This file contains the tile cache, its backing-file slots and the tile-by-tile operations.
+
+#include "raster/paged_plane.hxx"
+#include "raster/bounds.hxx"
+
+#include <algorithm> // for std::max(), std::min(), std::fill_n()
+#include <cstdint>   // for std::uint64_t
+#include <iterator>  // for std::prev()
+#include <limits>    // for std::numeric_limits
+
+#if !defined(_WIN32)
+#include <sys/types.h> // for off_t
+#endif
+
+namespace raster {
+
+namespace {
+
+// Slots lie at tileScanBytes * tile in the backing file, an offset that
+// outgrows a 32-bit long, the argument of std::fseek(), once the file
+// passes 2 GiB; seek with 64-bit offsets instead, refusing any offset
+// the platform cannot represent.
+bool seekSlot(std::FILE *file, std::size_t tileScanBytes, int tile) {
+  const std::uint64_t offset = static_cast<std::uint64_t>(tileScanBytes) * static_cast<std::uint64_t>(tile);
+#if defined(_WIN32)
+  if (offset > static_cast<std::uint64_t>(std::numeric_limits<__int64>::max()))
+    return false;
+  return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+  if (offset > static_cast<std::uint64_t>(std::numeric_limits<off_t>::max()))
+    return false;
+  return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+} // namespace
+
+PagedPlane::~PagedPlane() {
+  if (persistent)
+    flush();
+  close();
+}
+
+void PagedPlane::close() {
+  if (file != nullptr)
+    std::fclose(file);
+  file = nullptr;
+  persistent = false;
+  cache.clear();
+  resident.clear();
+  stored.clear();
+  blank.clear();
+  grid = TileGrid();
+}
+
+bool PagedPlane::create(int cx, int cy, std::size_t cacheTiles, const char *path, int tileSize) {
+  if (persistent)
+    flush();
+  close();
+  if (!grid.create(cx, cy, tileSize))
+    return false;
+  file = path == nullptr ? std::tmpfile() : std::fopen(path, "w+b");
+  if (file == nullptr) {
+    grid = TileGrid();
+    return false;
+  }
+  persistent = path != nullptr;
+  this->cacheTiles = std::max<std::size_t>(cacheTiles, 1U);
+  stored.assign(grid.tileCount(), false);
+  blank.assign(grid.tileStoreBytes(), 0U);
+  return true;
+}
+
+//**********************************************************************
+//                                                   PagedPlane::acquire
+//**********************************************************************
+//
+//**    Synopsis
+//
+//      Entry *acquire(tile, load)
+//
+//**    Description
+//
+//      Acquiring a tile makes it resident and most recently used.  A
+//      full cache first evicts its least recently used tile, reusing
+//      the evicted tile's bits rather than allocating.  Loading reads
+//      the tile's slot if it holds the tile, otherwise clears the bits;
+//      callers about to overwrite the whole tile skip the load.
+//
+//      Answers null if writing back the evicted tile or reading the
+//      slot fails.  A tile that fails to load stays out of the cache.
+//
+//**********************************************************************
+
+PagedPlane::Entry *PagedPlane::acquire(int tile, bool load) {
+  if (auto it = resident.find(tile); it != resident.end()) {
+    cache.splice(cache.begin(), cache, it->second);
+    return &cache.front();
+  }
+  if (cache.size() >= cacheTiles) {
+    Entry &victim = cache.back();
+    if (!writeBack(victim))
+      return nullptr;
+    resident.erase(victim.tile);
+    cache.splice(cache.begin(), cache, std::prev(cache.end()));
+  } else
+    cache.push_front({0, std::vector<scanbyte>(grid.tileStoreBytes(), 0U), false});
+  Entry &entry = cache.front();
+  entry.tile = tile;
+  entry.dirty = false;
+  if (load) {
+    const std::size_t tileScanBytes = grid.tileScanBytes();
+    if (!stored[tile])
+      std::fill_n(entry.bits.begin(), tileScanBytes, 0U);
+    else if (!seekSlot(file, tileScanBytes, tile) ||
+             std::fread(entry.bits.data(), 1U, tileScanBytes, file) != tileScanBytes) {
+      cache.splice(cache.end(), cache, cache.begin());
+      cache.pop_back();
+      return nullptr;
+    }
+  }
+  resident[tile] = cache.begin();
+  return &entry;
+}
+
+// PagedPlane::tileBits(tile)
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Reading needs no resident copy of a tile never written: every such
+// tile shares the blank bits.
+
+const scanbyte *PagedPlane::tileBits(int tile) {
+  if (!stored[tile] && !resident.contains(tile))
+    return blank.data();
+  Entry *entry = acquire(tile, true);
+  return entry == nullptr ? nullptr : entry->bits.data();
+}
+
+bool PagedPlane::writeBack(Entry &entry) {
+  if (!entry.dirty)
+    return true;
+  const std::size_t tileScanBytes = grid.tileScanBytes();
+  if (!seekSlot(file, tileScanBytes, entry.tile) ||
+      std::fwrite(entry.bits.data(), 1U, tileScanBytes, file) != tileScanBytes)
+    return false;
+  stored[entry.tile] = true;
+  entry.dirty = false;
+  return true;
+}
+
+bool PagedPlane::flush() {
+  bool flushed = true;
+  for (Entry &entry : cache)
+    flushed = writeBack(entry) && flushed;
+  return file != nullptr && std::fflush(file) == 0 && flushed;
+}
+
+//**********************************************************************
+//                                                    PagedPlane::bitBlt
+//**********************************************************************
+//
+//**    Synopsis
+//
+//      bool bitBlt(x, y, cx, cy, bitPlaneSrc, xSrc, ySrc, rop2)
+//      bool bitBlt(x, y, cx, cy, rop1)
+//
+//**    Description
+//
+//      Blits into a paged plane clip to the plane then acquire the tiles
+//      they cover one at a time, each transfer running through a bit
+//      plane over the resident tile.  Fills of zeros or ones covering a
+//      whole tile skip loading it, and clearing a tile never written
+//      does nothing at all.  A tile that fails to load stops the
+//      blit; tiles already written keep their new contents.
+//
+//**********************************************************************
+
+bool PagedPlane::bitBlt(int x, int y, int cx, int cy, const BitPlane &bitPlaneSrc, int xSrc, int ySrc, Rop2 rop2) {
+  if (!grid.clip(x, y, cx, cy, xSrc, ySrc))
+    return false;
+  bool transferred = false;
+  bool failed = false;
+  grid.forEachTile(x, y, cx, cy, [&](int i, int xTile, int yTile, int x0, int y0, int cx0, int cy0) {
+    if (failed)
+      return;
+    Entry *entry = acquire(i, true);
+    if (entry == nullptr) {
+      failed = true;
+      return;
+    }
+    BitPlane tile(grid.tileSize, grid.tileSize, entry->bits.data());
+    if (tile.bitBlt(x0 - xTile, y0 - yTile, cx0, cy0, bitPlaneSrc, xSrc + x0 - x, ySrc + y0 - y, rop2)) {
+      entry->dirty = true;
+      transferred = true;
+    }
+  });
+  return transferred && !failed;
+}
+
+bool PagedPlane::bitBlt(int x, int y, int cx, int cy, Rop1 rop1) {
+  int xSrc = 0, ySrc = 0;
+  if (!grid.clip(x, y, cx, cy, xSrc, ySrc))
+    return false;
+  bool failed = false;
+  grid.forEachTile(x, y, cx, cy, [&](int i, int xTile, int yTile, int x0, int y0, int cx0, int cy0) {
+    if (failed)
+      return;
+    const bool whole = rop1 != dstInvert && cx0 == grid.tileSize && cy0 == grid.tileSize;
+    if (whole && rop1 == blackness && !stored[i] && !resident.contains(i))
+      return;
+    Entry *entry = acquire(i, !whole);
+    if (entry == nullptr) {
+      failed = true;
+      return;
+    }
+    BitPlane tile(grid.tileSize, grid.tileSize, entry->bits.data());
+    tile.bitBlt(x0 - xTile, y0 - yTile, cx0, cy0, rop1);
+    entry->dirty = true;
+  });
+  return !failed;
+}
+
+// PagedPlane::render(bitPlaneDst, x, y, cx, cy, xSrc, ySrc, rop2)
+// ~~~~~~~~~~~~~~~~~~ ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Rendering clips the source rectangle to this plane, moving the
+// destination origin with it, then blits from each tile it covers.
+
+bool PagedPlane::render(BitPlane &bitPlaneDst, int x, int y, int cx, int cy, int xSrc, int ySrc, Rop2 rop2) {
+  if (!grid.clip(xSrc, ySrc, cx, cy, x, y))
+    return false;
+  bool transferred = false;
+  bool failed = false;
+  grid.forEachTile(xSrc, ySrc, cx, cy, [&](int i, int xTile, int yTile, int x0, int y0, int cx0, int cy0) {
+    if (failed)
+      return;
+    const scanbyte *bits = tileBits(i);
+    if (bits == nullptr) {
+      failed = true;
+      return;
+    }
+    const BitPlane tile(grid.tileSize, grid.tileSize, const_cast<scanbyte *>(bits));
+    if (bitPlaneDst.bitBlt(x + x0 - xSrc, y + y0 - ySrc, cx0, cy0, tile, x0 - xTile, y0 - yTile, rop2))
+      transferred = true;
+  });
+  return transferred && !failed;
+}
+
+Rect PagedPlane::boundingBox(bool set) {
+  int left = grid.width, top = grid.height, right = 0, bottom = 0;
+  const bool loaded = visitTiles([&](const BitPlane &tile, int xTile, int yTile) {
+    const Rect box = raster::boundingBox(tile, set);
+    if (box.empty())
+      return;
+    left = std::min(left, xTile + box.x);
+    top = std::min(top, yTile + box.y);
+    right = std::max(right, xTile + box.x + box.cx);
+    bottom = std::max(bottom, yTile + box.y + box.cy);
+  });
+  if (!loaded || left >= right)
+    return {};
+  return {left, top, right - left, bottom - top};
+}
+
+} // namespace raster
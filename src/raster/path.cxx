@@ -0,0 +1,218 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file path.cxx
+/// \brief Paths: polygons and Bézier curves filled by scan line.
+/// \details This file contains curve flattening and the active edge table behind path filling.
+
+#include "raster/path.hxx"
+#include "raster/draw.hxx"
+
+#include <algorithm> // for std::min(), std::max(), std::clamp(), std::sort()
+#include <cmath>     // for std::ceil(), std::floor(), std::sqrt(), std::hypot()
+#include <utility>   // for std::swap()
+
+namespace raster {
+
+namespace {
+
+// Co-ordinates far beyond any plane clamp to within int range.
+int toInt(double value) { return static_cast<int>(std::clamp(value, -1.0e9, 1.0e9)); }
+
+// First scan line or column whose pixel centre lies at or beyond value.
+int firstCentre(double value) { return toInt(std::ceil(value - 0.5)); }
+
+// An edge runs from its upper vertex x, y down to scan line yEnd,
+// crossing scan lines yFirst up to yEnd at their pixel centres.  The
+// winding is +1 for downward edges and -1 for upward.
+struct Edge {
+  double x;
+  double y;
+  double dxdy;
+  int yFirst;
+  int yEnd;
+  int winding;
+};
+
+// A crossing is where an active edge meets the current scan line.
+struct Crossing {
+  double x;
+  const Edge *edge;
+};
+
+} // namespace
+
+void Path::moveTo(double x, double y) {
+  starts.push_back(vertices.size());
+  vertices.push_back({x, y});
+}
+
+void Path::lineTo(double x, double y) {
+  if (starts.empty())
+    starts.push_back(vertices.size());
+  vertices.push_back({x, y});
+}
+
+// Path::curveTo(x1, y1, x2, y2, x3, y3)
+// ~~~~~~~~~~~~~ ~~~~~~~~~~~~~~~~~~~~~~~
+// Uniform steps along a cubic stray from the curve by at most 3/4 of
+// its largest second difference divided by the square of the step
+// count.  The step count therefore follows from the flatness.
+
+void Path::curveTo(double x1, double y1, double x2, double y2, double x3, double y3) {
+  if (vertices.empty() || starts.empty()) {
+    lineTo(x3, y3);
+    return;
+  }
+  const Vertex v0 = vertices.back();
+  const double dd = std::max(std::hypot(v0.x - 2 * x1 + x2, v0.y - 2 * y1 + y2),
+                             std::hypot(x1 - 2 * x2 + x3, y1 - 2 * y2 + y3));
+  const double steps = std::ceil(std::sqrt(0.75 * dd / std::max(flatness, 1.0e-3)));
+  const int n = static_cast<int>(std::clamp(steps, 1.0, 1024.0));
+  for (int i = 1; i < n; ++i) {
+    const double t = static_cast<double>(i) / n;
+    const double u = 1 - t;
+    const double a = u * u * u;
+    const double b = 3 * u * u * t;
+    const double c = 3 * u * t * t;
+    const double d = t * t * t;
+    vertices.push_back({a * v0.x + b * x1 + c * x2 + d * x3, a * v0.y + b * y1 + c * y2 + d * y3});
+  }
+  vertices.push_back({x3, y3});
+}
+
+void Path::close() {
+  if (starts.empty() || starts.back() == vertices.size())
+    return;
+  const Vertex start = vertices[starts.back()];
+  moveTo(start.x, start.y);
+}
+
+void Path::clear() {
+  vertices.clear();
+  starts.clear();
+}
+
+Rect Path::bounds() const {
+  if (vertices.empty())
+    return {};
+  double left = vertices.front().x;
+  double top = vertices.front().y;
+  double right = left;
+  double bottom = top;
+  for (const Vertex &vertex : vertices) {
+    left = std::min(left, vertex.x);
+    top = std::min(top, vertex.y);
+    right = std::max(right, vertex.x);
+    bottom = std::max(bottom, vertex.y);
+  }
+  const int x = toInt(std::floor(left));
+  const int y = toInt(std::floor(top));
+  return {x, y, toInt(std::ceil(right)) - x, toInt(std::ceil(bottom)) - y};
+}
+
+//**********************************************************************
+//                                                              fillPath
+//**********************************************************************
+//
+//**    Synopsis
+//
+//      bool fillPath(bitPlane, path, fillRule, rop2, yBand)
+//
+//**    Description
+//
+//      The edge table lists the path's non-horizontal edges sorted by
+//      first scan line.  Walking down the band's scan lines, edges join
+//      the active edge table when they reach the scan line and leave it
+//      when they pass.  Each scan line intersects every active edge at
+//      the pixel centres, sorts the crossings by x, then sums their
+//      windings left to right; the fill rule turns the running sum into
+//      inside or outside, and every stretch inside becomes one span.
+//      The active edge table keeps the order of the previous scan line's
+//      crossings; crossings rarely change order from one scan line to
+//      the next, so insertion sort costs little.
+//
+//      Every crossing derives from its edge's upper vertex rather than
+//      accumulating steps, so bands meet without seams.  Scan lines
+//      with no active edges skip ahead to the next edge.
+//
+//**********************************************************************
+
+bool fillPath(BitPlane &bitPlane, const Path &path, FillRule fillRule, Rop2 rop2, int yBand) {
+  const int yStop = yBand + bitPlane.getHeight();
+  std::vector<Edge> edges;
+  for (std::size_t i = 0; i < path.starts.size(); ++i) {
+    const std::size_t first = path.starts[i];
+    const std::size_t end = i + 1 < path.starts.size() ? path.starts[i + 1] : path.vertices.size();
+    for (std::size_t j = first; j < end; ++j) {
+      Path::Vertex v0 = path.vertices[j];
+      Path::Vertex v1 = path.vertices[j + 1 < end ? j + 1 : first];
+      int winding = 1;
+      if (v1.y < v0.y) {
+        std::swap(v0, v1);
+        winding = -1;
+      }
+      const int yFirst = std::max(firstCentre(v0.y), yBand);
+      const int yEnd = std::min(firstCentre(v1.y), yStop);
+      if (yFirst < yEnd)
+        edges.push_back({v0.x, v0.y, (v1.x - v0.x) / (v1.y - v0.y), yFirst, yEnd, winding});
+    }
+  }
+  if (edges.empty())
+    return false;
+  std::sort(edges.begin(), edges.end(), [](const Edge &a, const Edge &b) { return a.yFirst < b.yFirst; });
+
+  SpanWriter writer(bitPlane, rop2);
+  std::vector<const Edge *> active;
+  std::vector<Crossing> crossings;
+  bool drew = false;
+  std::size_t next = 0;
+  for (int y = edges.front().yFirst; y < yStop && (next < edges.size() || !active.empty()); ++y) {
+    std::erase_if(active, [y](const Edge *edge) { return edge->yEnd <= y; });
+    if (active.empty() && next < edges.size() && edges[next].yFirst > y)
+      y = edges[next].yFirst;
+    for (; next < edges.size() && edges[next].yFirst <= y; ++next)
+      active.push_back(&edges[next]);
+
+    const double yCentre = y + 0.5;
+    crossings.clear();
+    for (const Edge *edge : active) {
+      const Crossing crossing{edge->x + (yCentre - edge->y) * edge->dxdy, edge};
+      auto at = crossings.end();
+      while (at != crossings.begin() && crossing.x < (at - 1)->x)
+        --at;
+      crossings.insert(at, crossing);
+    }
+    for (std::size_t i = 0; i < crossings.size(); ++i)
+      active[i] = crossings[i].edge;
+
+    int winding = 0;
+    int xInside = 0;
+    for (const Crossing &crossing : crossings) {
+      const bool wasInside = fillRule == FillRule::evenOdd ? (winding & 1) != 0 : winding != 0;
+      winding += crossing.edge->winding;
+      const bool inside = fillRule == FillRule::evenOdd ? (winding & 1) != 0 : winding != 0;
+      if (inside && !wasInside)
+        xInside = firstCentre(crossing.x);
+      else if (!inside && wasInside)
+        drew = writer.span(xInside, firstCentre(crossing.x), y - yBand) || drew;
+    }
+  }
+  return drew;
+}
+
+} // namespace raster
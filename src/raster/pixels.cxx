@@ -0,0 +1,272 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file pixels.cxx
+/// \brief Enumeration of set pixels and horizontal runs.
+/// \details This file contains the bit-scanning search functions, iterators and extractors.
+
+#include "raster/pixels.hxx"
+
+#include <algorithm> // for std::min()
+#include <bit>       // for std::countl_zero(), std::popcount()
+#include <vector>
+
+namespace raster {
+
+namespace {
+
+// Scan words load in scan order, the leftmost pixel in the most signi-
+// ficant bit, so counting leading zeros gives the distance to the next
+// set pixel.  Searching for clear pixels inverts the words.  Bits beyond
+// the width, including scan bytes beyond the scan line, never count:
+// results clamp to the width.  Searches for set pixels skip scan lines
+// and scan words that the occupancy summary, if any, shows empty.
+
+template <bool set> int nextPixel(const BitPlane &bitPlane, int x, int y) {
+  const int cx = bitPlane.getWidth();
+  if (x < 0)
+    x = 0;
+  if (x >= cx)
+    return cx;
+  if constexpr (set)
+    if (!bitPlane.isRowOccupied(y))
+      return cx;
+  const std::size_t scanByteCount = (static_cast<std::size_t>(cx) + 7U) >> 3;
+  const scanbyte *scan = bitPlane.bits(0, y);
+  // Scan words start at multiples of eight scan bytes, like the occupancy
+  // summary's; the first word masks off pixels left of x.
+  std::size_t offset = static_cast<std::size_t>(x >> 6) << 3;
+  scanword mask = ~scanword(0U) >> (x & 63);
+  for (; offset < scanByteCount; offset += sizeof(scanword)) {
+    if constexpr (set)
+      if (!bitPlane.isWordOccupied(y, offset)) {
+        mask = ~scanword(0U);
+        continue;
+      }
+    const std::size_t count = std::min(scanByteCount - offset, sizeof(scanword));
+    scanword w = loadScanOrder(scan + offset, count);
+    if constexpr (!set)
+      w = ~w;
+    w &= mask;
+    if (w != 0U)
+      return std::min(static_cast<int>(offset * 8U) + std::countl_zero(w), cx);
+    mask = ~scanword(0U);
+  }
+  return cx;
+}
+
+// Emits every set pixel of scan line y, a scan word at a time: while a
+// word has set bits, emit the leading one and clear it.
+
+template <typename Emit> void scanPixels(const BitPlane &bitPlane, int y, Emit &&emit) {
+  if (!bitPlane.isRowOccupied(y))
+    return;
+  const int cx = bitPlane.getWidth();
+  const std::size_t scanByteCount = (static_cast<std::size_t>(cx) + 7U) >> 3;
+  const scanbyte *scan = bitPlane.bits(0, y);
+  for (std::size_t offset = 0; offset < scanByteCount; offset += sizeof(scanword)) {
+    if (!bitPlane.isWordOccupied(y, offset))
+      continue;
+    scanword w = loadScanOrder(scan + offset, std::min(scanByteCount - offset, sizeof(scanword)));
+    const int xWord = static_cast<int>(offset * 8U);
+    if (cx - xWord < 64)
+      w &= ~(~scanword(0U) >> (cx - xWord));
+    while (w != 0U) {
+      const int lz = std::countl_zero(w);
+      emit(xWord + lz);
+      w &= ~(scanword(1U) << (63 - lz));
+    }
+  }
+}
+
+std::size_t countPixels(const BitPlane &bitPlane, int y) {
+  std::size_t n = 0U;
+  if (!bitPlane.isRowOccupied(y))
+    return n;
+  const int cx = bitPlane.getWidth();
+  const std::size_t scanByteCount = (static_cast<std::size_t>(cx) + 7U) >> 3;
+  const scanbyte *scan = bitPlane.bits(0, y);
+  for (std::size_t offset = 0; offset < scanByteCount; offset += sizeof(scanword)) {
+    if (!bitPlane.isWordOccupied(y, offset))
+      continue;
+    scanword w = loadScanOrder(scan + offset, std::min(scanByteCount - offset, sizeof(scanword)));
+    const int xWord = static_cast<int>(offset * 8U);
+    if (cx - xWord < 64)
+      w &= ~(~scanword(0U) >> (cx - xWord));
+    n += static_cast<std::size_t>(std::popcount(w));
+  }
+  return n;
+}
+
+template <typename Emit> void scanRuns(const BitPlane &bitPlane, int y, Emit &&emit) {
+  const int cx = bitPlane.getWidth();
+  for (int x = nextSet(bitPlane, 0, y); x < cx;) {
+    const int x1 = nextClear(bitPlane, x, y);
+    emit(x, x1);
+    x = nextSet(bitPlane, x1, y);
+  }
+}
+
+std::size_t countRuns(const BitPlane &bitPlane, int y) {
+  std::size_t n = 0U;
+  scanRuns(bitPlane, y, [&](int, int) { ++n; });
+  return n;
+}
+
+// Bulk extraction in parallel takes two passes.  The first counts per
+// scan line, the second writes each scan line's pixels or runs at the
+// offset given by the running total of the counts before it.  Bands
+// write disjoint parts of the buffer.
+
+template <typename Count, typename Write>
+std::size_t extractWith(const execution::parallel_policy &policy, const BitPlane &bitPlane, Count &&count,
+                        Write &&write) {
+  const int cy = bitPlane.getHeight();
+  const std::size_t scanByteCount = (static_cast<std::size_t>(bitPlane.getWidth()) + 7U) >> 3;
+  std::vector<std::size_t> offsets(static_cast<std::size_t>(cy) + 1U, 0U);
+  execution::forEachBand(policy, cy, scanByteCount, [&](int yBand, int cyBand) {
+    for (int y = yBand; y < yBand + cyBand; ++y)
+      offsets[y + 1] = count(y);
+  });
+  for (int y = 0; y < cy; ++y)
+    offsets[y + 1] += offsets[y];
+  execution::forEachBand(policy, cy, scanByteCount, [&](int yBand, int cyBand) {
+    for (int y = yBand; y < yBand + cyBand; ++y)
+      write(y, offsets[y]);
+  });
+  return offsets[cy];
+}
+
+} // namespace
+
+int nextSet(const BitPlane &bitPlane, int x, int y) { return nextPixel<true>(bitPlane, x, y); }
+
+int nextClear(const BitPlane &bitPlane, int x, int y) { return nextPixel<false>(bitPlane, x, y); }
+
+void SetPixels::iterator::advance(int x) {
+  const int cx = bitPlane->getWidth();
+  const int cy = bitPlane->getHeight();
+  for (int y = point.y; y < cy; y = bitPlane->nextOccupiedRow(y + 1), x = 0) {
+    const int xSet = nextSet(*bitPlane, x, y);
+    if (xSet < cx) {
+      point = {xSet, y};
+      return;
+    }
+  }
+  point = {0, cy};
+}
+
+void SetRuns::iterator::advance(int x) {
+  const int cx = bitPlane->getWidth();
+  const int cy = bitPlane->getHeight();
+  for (int y = run.y; y < cy; y = bitPlane->nextOccupiedRow(y + 1), x = 0) {
+    const int x0 = nextSet(*bitPlane, x, y);
+    if (x0 < cx) {
+      run = {y, x0, nextClear(*bitPlane, x0, y)};
+      return;
+    }
+  }
+  run = {cy, 0, 0};
+}
+
+//**********************************************************************
+//                                           extractPixels & extractRuns
+//**********************************************************************
+//
+//**    Description
+//
+//      The extractors fill caller-allocated structure-of-arrays buffers:
+//      separate arrays of y and x for pixels; of y, x0 and x1 for runs.
+//      They stop writing when the buffer fills but carry on counting,
+//      so the answer tells the caller how large a buffer to allocate
+//      next time.
+//
+//**********************************************************************
+
+std::size_t extractPixels(const BitPlane &bitPlane, PixelBuffer buffer) {
+  const std::size_t capacity = std::min(buffer.x.size(), buffer.y.size());
+  std::size_t n = 0U;
+  for (int y = bitPlane.nextOccupiedRow(0); y < bitPlane.getHeight(); y = bitPlane.nextOccupiedRow(y + 1))
+    scanPixels(bitPlane, y, [&](int x) {
+      if (n < capacity) {
+        buffer.x[n] = x;
+        buffer.y[n] = y;
+      }
+      ++n;
+    });
+  return n;
+}
+
+std::size_t extractPixels(const execution::sequenced_policy &, const BitPlane &bitPlane, PixelBuffer buffer) {
+  return extractPixels(bitPlane, buffer);
+}
+
+std::size_t extractPixels(const execution::parallel_policy &policy, const BitPlane &bitPlane, PixelBuffer buffer) {
+  const std::size_t capacity = std::min(buffer.x.size(), buffer.y.size());
+  return extractWith(
+      policy, bitPlane, [&](int y) { return countPixels(bitPlane, y); },
+      [&](int y, std::size_t n) {
+        if (n >= capacity)
+          return;
+        scanPixels(bitPlane, y, [&](int x) {
+          if (n < capacity) {
+            buffer.x[n] = x;
+            buffer.y[n] = y;
+          }
+          ++n;
+        });
+      });
+}
+
+std::size_t extractRuns(const BitPlane &bitPlane, RunBuffer buffer) {
+  const std::size_t capacity = std::min({buffer.y.size(), buffer.x0.size(), buffer.x1.size()});
+  std::size_t n = 0U;
+  for (int y = bitPlane.nextOccupiedRow(0); y < bitPlane.getHeight(); y = bitPlane.nextOccupiedRow(y + 1))
+    scanRuns(bitPlane, y, [&](int x0, int x1) {
+      if (n < capacity) {
+        buffer.y[n] = y;
+        buffer.x0[n] = x0;
+        buffer.x1[n] = x1;
+      }
+      ++n;
+    });
+  return n;
+}
+
+std::size_t extractRuns(const execution::sequenced_policy &, const BitPlane &bitPlane, RunBuffer buffer) {
+  return extractRuns(bitPlane, buffer);
+}
+
+std::size_t extractRuns(const execution::parallel_policy &policy, const BitPlane &bitPlane, RunBuffer buffer) {
+  const std::size_t capacity = std::min({buffer.y.size(), buffer.x0.size(), buffer.x1.size()});
+  return extractWith(
+      policy, bitPlane, [&](int y) { return countRuns(bitPlane, y); },
+      [&](int y, std::size_t n) {
+        if (n >= capacity)
+          return;
+        scanRuns(bitPlane, y, [&](int x0, int x1) {
+          if (n < capacity) {
+            buffer.y[n] = y;
+            buffer.x0[n] = x0;
+            buffer.x1[n] = x1;
+          }
+          ++n;
+        });
+      });
+}
+
+} // namespace raster
@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file profile.cxx
+/// \brief Row and column projection profiles of bit planes.
+/// \details This file contains the implementation of the projection profiles.
+
+#include "raster/profile.hxx"
+
+#include <algorithm> // for std::fill(), std::max(), std::min()
+#include <bit>       // for std::popcount()
+#include <vector>
+
+namespace raster {
+
+namespace {
+
+// Both profiles clip the rectangle to the plane then work on whole scan
+// bytes from the one holding the left column to the one holding the
+// right.  Edge masks drop the bits outside the rectangle.  The clipped
+// rectangle's origin relative to the requested origin gives the first
+// count to fill.
+
+struct Clipped {
+  int x0, y0, x1, y1;
+  bool empty() const { return x0 >= x1 || y0 >= y1; }
+};
+
+Clipped clipProfile(const BitPlane &bitPlane, int x, int y, int cx, int cy) {
+  return {std::max(x, 0), std::max(y, 0), std::min(x + std::max(cx, 0), bitPlane.getWidth()),
+          std::min(y + std::max(cy, 0), bitPlane.getHeight())};
+}
+
+} // namespace
+
+//**********************************************************************
+//                                                            rowProfile
+//**********************************************************************
+//
+//**    Description
+//
+//      A scan line's count is the population count of its masked edge
+//      scan bytes plus that of the scan words in between.  Scan lines
+//      that the occupancy summary shows empty count zero without loads.
+//
+//**********************************************************************
+
+bool rowProfile(const BitPlane &bitPlane, int x, int y, int cx, int cy, std::span<std::uint32_t> counts) {
+  std::fill(counts.begin(), counts.begin() + std::max(cy, 0), 0U);
+  const Clipped clip = clipProfile(bitPlane, x, y, cx, cy);
+  if (clip.empty())
+    return false;
+  const int xMax = clip.x1 - 1;
+  const int extraScanByteCount = (xMax >> 3) - (clip.x0 >> 3);
+  const scanbyte scanOrgMask = 0xffU >> (clip.x0 & 7);
+  const scanbyte scanExtMask = 0xffU << (7 - (xMax & 7));
+  for (int yy = bitPlane.nextOccupiedRow(clip.y0); yy < clip.y1; yy = bitPlane.nextOccupiedRow(yy + 1)) {
+    const scanbyte *scan = bitPlane.bits(clip.x0, yy);
+    std::uint32_t count;
+    if (extraScanByteCount == 0)
+      count = std::popcount(static_cast<scanbyte>(*scan & scanOrgMask & scanExtMask));
+    else {
+      count = std::popcount(static_cast<scanbyte>(scan[0] & scanOrgMask)) +
+              std::popcount(static_cast<scanbyte>(scan[extraScanByteCount] & scanExtMask));
+      forEachScan(static_cast<std::size_t>(extraScanByteCount - 1), [&](std::size_t offset, auto unit) {
+        using Word = decltype(unit);
+        count += std::popcount(loadScan<Word>(scan + 1 + offset));
+      });
+    }
+    counts[yy - y] = count;
+  }
+  return true;
+}
+
+//**********************************************************************
+//                                                         columnProfile
+//**********************************************************************
+//
+//**    Description
+//
+//      Column counts accumulate vertically in bit-sliced counters, one
+//      set of eight slices per scan word across the rectangle.  Each
+//      scan line adds its scan words into the counters with a ripple
+//      carry, 64 columns per operation.  Eight slices count up to 255,
+//      so every 255 scan lines, and at the end, the slices flush into
+//      the integer counts and reset.  Flushing costs a few operations per
+//      column; amortised over 255 scan lines it is negligible.
+//
+//**********************************************************************
+
+bool columnProfile(const BitPlane &bitPlane, int x, int y, int cx, int cy, std::span<std::uint32_t> counts) {
+  std::fill(counts.begin(), counts.begin() + std::max(cx, 0), 0U);
+  const Clipped clip = clipProfile(bitPlane, x, y, cx, cy);
+  if (clip.empty())
+    return false;
+  constexpr int sliceCount = 8;
+  constexpr int flushLines = (1 << sliceCount) - 1;
+  const int xByte = clip.x0 & ~7;
+  const std::size_t scanByteCount = static_cast<std::size_t>(((clip.x1 - 1) >> 3) - (clip.x0 >> 3) + 1);
+  const std::size_t wordCount = (scanByteCount + sizeof(scanword) - 1U) / sizeof(scanword);
+  std::vector<scanword> slices(wordCount * sliceCount, 0U);
+
+  auto flush = [&] {
+    for (std::size_t j = 0; j < wordCount; ++j) {
+      scanword *slice = &slices[j * sliceCount];
+      const int xWord = xByte + static_cast<int>(j * 64U);
+      const int xBegin = std::max(xWord, clip.x0);
+      const int xEnd = std::min(xWord + 64, clip.x1);
+      for (int xx = xBegin; xx < xEnd; ++xx) {
+        const int shift = 63 - (xx - xWord);
+        std::uint32_t count = 0U;
+        for (int i = 0; i < sliceCount; ++i)
+          count |= static_cast<std::uint32_t>((slice[i] >> shift) & 1U) << i;
+        counts[xx - x] += count;
+      }
+      std::fill(slice, slice + sliceCount, scanword(0U));
+    }
+  };
+
+  int lines = 0;
+  for (int yy = clip.y0; yy < clip.y1; ++yy) {
+    const scanbyte *scan = bitPlane.bits(xByte, yy);
+    for (std::size_t j = 0; j < wordCount; ++j) {
+      const std::size_t offset = j * sizeof(scanword);
+      const std::size_t count = scanByteCount - offset;
+      scanword carry = loadScanOrder(scan + offset, count < sizeof(scanword) ? count : sizeof(scanword));
+      scanword *slice = &slices[j * sliceCount];
+      for (int i = 0; carry != 0U && i < sliceCount; ++i) {
+        const scanword sum = slice[i] ^ carry;
+        carry &= slice[i];
+        slice[i] = sum;
+      }
+    }
+    if (++lines == flushLines) {
+      flush();
+      lines = 0;
+    }
+  }
+  if (lines != 0)
+    flush();
+  return true;
+}
+
+} // namespace raster
@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file reduce.cxx
+/// \brief N-ary reductions across bit planes.
+/// \details This file contains the implementation of the reductions, including the bit-sliced counters behind
+///          the threshold reductions.
+
+#include "raster/reduce.hxx"
+
+#include <bit>    // for std::bit_width()
+#include <vector> // for std::vector
+
+namespace raster {
+
+namespace {
+
+// Bit-sliced counting
+// ~~~~~~~~~~ ~~~~~~~~
+// Threshold reductions count, for every bit position, how many operand
+// planes have the bit set.  Counting happens one scan word at a time,
+// 64 positions in parallel.  The count is ``bit sliced'': word counter[i]
+// holds bit i of all 64 counts.  Adding an operand word ripples a carry
+// up through the slices, exactly like a binary full adder but on 64
+// lanes at once.  There are only enough slices to count up to k; a
+// carry out of the top slice means the count exceeds every value the
+// slices can hold, hence exceeds k, and sticks in the overflow word.
+//
+// The comparison with k runs from the most significant slice down,
+// tracking lanes known to be greater (gt) and lanes equal so far (eq).
+
+template <typename Word>
+Word reduceWord(const std::vector<const scanbyte *> &scans, std::size_t offset, Reduction reduction, int k,
+                int sliceCount) {
+  Word w = loadScan<Word>(scans[0] + offset);
+  switch (reduction) {
+  case reduceOr:
+    for (std::size_t i = 1; i < scans.size(); ++i)
+      w |= loadScan<Word>(scans[i] + offset);
+    return w;
+  case reduceAnd:
+    for (std::size_t i = 1; i < scans.size(); ++i)
+      w &= loadScan<Word>(scans[i] + offset);
+    return w;
+  case reduceXor:
+    for (std::size_t i = 1; i < scans.size(); ++i)
+      w ^= loadScan<Word>(scans[i] + offset);
+    return w;
+  default:
+    break;
+  }
+  Word counter[32] = {};
+  Word overflow = 0;
+  for (const scanbyte *scan : scans) {
+    Word carry = loadScan<Word>(scan + offset);
+    for (int i = 0; carry != 0 && i < sliceCount; ++i) {
+      const Word sum = counter[i] ^ carry;
+      carry &= counter[i];
+      counter[i] = sum;
+    }
+    overflow |= carry;
+  }
+  Word gt = 0;
+  Word eq = static_cast<Word>(~Word(0));
+  for (int i = sliceCount - 1; i >= 0; --i)
+    if ((k >> i) & 1)
+      eq &= counter[i];
+    else {
+      gt |= eq & counter[i];
+      eq &= ~counter[i];
+    }
+  return static_cast<Word>(overflow | gt | eq);
+}
+
+template <typename Policy>
+bool reduceWith(const Policy &policy, BitPlane &bitPlane, std::span<const BitPlane *const> bitPlanes,
+                Reduction reduction, int k) {
+  if (bitPlanes.empty())
+    return false;
+  const int cx = bitPlane.getWidth();
+  const int cy = bitPlane.getHeight();
+  for (const BitPlane *bitPlaneSrc : bitPlanes)
+    if (bitPlaneSrc->getWidth() != cx || bitPlaneSrc->getHeight() != cy)
+      return false;
+  if (cx == 0 || cy == 0)
+    return false;
+  if (reduction == reduceMajority) {
+    reduction = reduceAtLeast;
+    k = static_cast<int>(bitPlanes.size() / 2 + 1);
+  }
+  if (k < 0)
+    k = 0;
+  const int sliceCount = std::bit_width(static_cast<unsigned>(k));
+  if (reduction == reduceAtLeast && sliceCount > 31)
+    return false;
+
+  // All but the last scan byte store whole; the last stores masked so
+  // that bits beyond the width survive.  Scan words cover as much of
+  // the scan line as they can, scan bytes the rest.
+  const std::size_t scanByteCount = (static_cast<std::size_t>(cx) + 7U) >> 3;
+  const scanbyte scanExtMask = 0xffU << ((8 - (cx & 7)) & 7);
+  execution::forEachBand(policy, cy, scanByteCount * bitPlanes.size(), [&](int yBand, int cyBand) {
+    std::vector<const scanbyte *> scans(bitPlanes.size());
+    for (int y = yBand; y < yBand + cyBand; ++y) {
+      for (std::size_t i = 0; i < bitPlanes.size(); ++i)
+        scans[i] = bitPlanes[i]->bits(0, y);
+      scanbyte *store = bitPlane.bits(0, y);
+      std::size_t offset = 0;
+      for (; offset + sizeof(scanword) < scanByteCount; offset += sizeof(scanword))
+        storeScanWord(store + offset, reduceWord<scanword>(scans, offset, reduction, k, sliceCount));
+      for (; offset + 1 < scanByteCount; ++offset)
+        store[offset] = reduceWord<scanbyte>(scans, offset, reduction, k, sliceCount);
+      const scanbyte last = reduceWord<scanbyte>(scans, offset, reduction, k, sliceCount);
+      store[offset] = (store[offset] & ~scanExtMask) | (last & scanExtMask);
+    }
+    bitPlane.touch(0, yBand, cx, cyBand);
+  });
+  return true;
+}
+
+} // namespace
+
+//**********************************************************************
+//                                                                reduce
+//**********************************************************************
+//
+//**    Synopsis
+//
+//      bool reduce([policy,] bitPlane, bitPlanes, reduction, k)
+//
+//**    Description
+//
+//      Reduce combines any number of operand planes into the destin-
+//      ation plane.  Reductions OR, AND and XOR need no explanation.
+//      Reduction reduceAtLeast sets a destination bit where at least k
+//      operand bits are set; reduceMajority where more than half are
+//      set.  The threshold reductions count with bit-sliced counters;
+//      either way, memory traffic amounts to one read per operand scan
+//      byte and one write per destination scan byte.
+//
+//      The scan line loop reads the operands in lock step: all operands'
+//      first scan words, then all operands' second, and so on.  Operand
+//      scan lines therefore stream through the cache together.
+//
+//**********************************************************************
+
+bool reduce(BitPlane &bitPlane, std::span<const BitPlane *const> bitPlanes, Reduction reduction, int k) {
+  return reduceWith(execution::seq, bitPlane, bitPlanes, reduction, k);
+}
+
+bool reduce(const execution::sequenced_policy &policy, BitPlane &bitPlane, std::span<const BitPlane *const> bitPlanes,
+            Reduction reduction, int k) {
+  return reduceWith(policy, bitPlane, bitPlanes, reduction, k);
+}
+
+bool reduce(const execution::parallel_policy &policy, BitPlane &bitPlane, std::span<const BitPlane *const> bitPlanes,
+            Reduction reduction, int k) {
+  return reduceWith(policy, bitPlane, bitPlanes, reduction, k);
+}
+
+} // namespace raster
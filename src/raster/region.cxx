@@ -0,0 +1,201 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file region.cxx
+/// \brief Regions: sets of pixels as banded rectangles.
+/// \details This file contains the band sweep behind region union, intersection and subtraction.
+
+#include "raster/region.hxx"
+
+#include <algorithm> // for std::min(), std::max(), std::sort(), std::unique()
+#include <climits>   // for INT_MAX
+
+namespace raster {
+
+namespace {
+
+// A span is a band's column interval, x0 up to but excluding x1.
+struct Span {
+  int x0;
+  int x1;
+  friend bool operator==(const Span &, const Span &) = default;
+};
+
+// Index of the first rectangle after the band starting at index i.
+std::size_t bandEnd(const std::vector<Rect> &rects, std::size_t i) {
+  const int y = rects[i].y;
+  while (++i < rects.size() && rects[i].y == y)
+    ;
+  return i;
+}
+
+// Spans of a region between y0 and y1, a sub-interval of at most one
+// band.  Index i tracks the sweep; bands above y0 drop behind.
+void bandSpans(const std::vector<Rect> &rects, std::size_t &i, int y0, std::vector<Span> &spans) {
+  spans.clear();
+  while (i < rects.size() && rects[i].y + rects[i].cy <= y0)
+    i = bandEnd(rects, i);
+  if (i == rects.size() || rects[i].y > y0)
+    return;
+  for (std::size_t j = i; j < rects.size() && rects[j].y == rects[i].y; ++j)
+    spans.push_back({rects[j].x, rects[j].x + rects[j].cx});
+}
+
+// Merge two span lists, keeping columns where op(inA, inB) holds, and
+// joining touching output spans.
+template <typename Op>
+void mergeSpans(const std::vector<Span> &a, const std::vector<Span> &b, Op op, std::vector<Span> &out) {
+  out.clear();
+  std::size_t i = 0, j = 0;
+  int x = std::min(a.empty() ? INT_MAX : a[0].x0, b.empty() ? INT_MAX : b[0].x0);
+  while (i < a.size() || j < b.size()) {
+    while (i < a.size() && a[i].x1 <= x)
+      ++i;
+    while (j < b.size() && b[j].x1 <= x)
+      ++j;
+    if (i == a.size() && j == b.size())
+      break;
+    const bool inA = i < a.size() && a[i].x0 <= x;
+    const bool inB = j < b.size() && b[j].x0 <= x;
+    // Next column where either membership changes.
+    int next = INT_MAX;
+    if (i < a.size())
+      next = std::min(next, inA ? a[i].x1 : a[i].x0);
+    if (j < b.size())
+      next = std::min(next, inB ? b[j].x1 : b[j].x0);
+    if (op(inA, inB)) {
+      if (!out.empty() && out.back().x1 == x)
+        out.back().x1 = next;
+      else
+        out.push_back({x, next});
+    }
+    x = next;
+  }
+}
+
+} // namespace
+
+Region::Region(Rect rect) {
+  if (rect.cx < 0) {
+    rect.x += rect.cx;
+    rect.cx = -rect.cx;
+  }
+  if (rect.cy < 0) {
+    rect.y += rect.cy;
+    rect.cy = -rect.cy;
+  }
+  if (!rect.empty())
+    rects.push_back(rect);
+}
+
+Rect Region::bounds() const {
+  if (rects.empty())
+    return {};
+  int x0 = rects.front().x;
+  int x1 = rects.front().x + rects.front().cx;
+  for (const Rect &rect : rects) {
+    x0 = std::min(x0, rect.x);
+    x1 = std::max(x1, rect.x + rect.cx);
+  }
+  const int y0 = rects.front().y;
+  const int y1 = rects.back().y + rects.back().cy;
+  return {x0, y0, x1 - x0, y1 - y0};
+}
+
+bool Region::contains(int x, int y) const {
+  for (const Rect &rect : rects) {
+    if (rect.y > y)
+      break;
+    if (y < rect.y + rect.cy && rect.x <= x && x < rect.x + rect.cx)
+      return true;
+  }
+  return false;
+}
+
+void Region::offset(int dx, int dy) {
+  for (Rect &rect : rects) {
+    rect.x += dx;
+    rect.y += dy;
+  }
+}
+
+//**********************************************************************
+//                                                       Region::combine
+//**********************************************************************
+//
+//**    Description
+//
+//      Combine sweeps down the sorted, distinct band edges of both
+//      regions.  Each interval between successive edges lies within at
+//      most one band of each region, so each region contributes one
+//      list of spans.  Merging the lists gives the result's spans for
+//      the interval.  A new band whose spans match those of the band
+//      just above, and which starts where that band ends, extends it
+//      rather than starting a band of its own.
+//
+//**********************************************************************
+
+template <typename Op> Region Region::combine(const Region &other, Op op) const {
+  std::vector<int> edges;
+  edges.reserve(2U * (rects.size() + other.rects.size()));
+  for (const std::vector<Rect> *r : {&rects, &other.rects})
+    for (const Rect &rect : *r) {
+      edges.push_back(rect.y);
+      edges.push_back(rect.y + rect.cy);
+    }
+  std::sort(edges.begin(), edges.end());
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+  Region result;
+  std::vector<Span> a, b, spans, above;
+  std::size_t i = 0, j = 0;
+  std::size_t aboveIndex = 0; // first rectangle of the band above
+  for (std::size_t k = 0; k + 1 < edges.size(); ++k) {
+    const int y0 = edges[k];
+    const int y1 = edges[k + 1];
+    bandSpans(rects, i, y0, a);
+    bandSpans(other.rects, j, y0, b);
+    mergeSpans(a, b, op, spans);
+    if (spans.empty())
+      continue;
+    std::vector<Rect> &out = result.rects;
+    if (!out.empty() && out.back().y + out.back().cy == y0 && spans == above) {
+      for (std::size_t n = aboveIndex; n < out.size(); ++n)
+        out[n].cy = y1 - out[n].y;
+      continue;
+    }
+    aboveIndex = out.size();
+    for (const Span &span : spans)
+      out.push_back({span.x0, y0, span.x1 - span.x0, y1 - y0});
+    above.swap(spans);
+  }
+  return result;
+}
+
+Region Region::unite(const Region &other) const {
+  return combine(other, [](bool inA, bool inB) { return inA || inB; });
+}
+
+Region Region::intersect(const Region &other) const {
+  return combine(other, [](bool inA, bool inB) { return inA && inB; });
+}
+
+Region Region::subtract(const Region &other) const {
+  return combine(other, [](bool inA, bool inB) { return inA && !inB; });
+}
+
+} // namespace raster
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: MIT
+///
+/// \copyright 2026, Roy Ratcliffe, Northumberland, United Kingdom
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+/// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+/// rights to use, copy, modify, merge, publish, distribute, sub-license, and/or sell copies of the Software, and to
+/// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+///
+///     The above copyright notice and this permission notice shall be included in all copies or substantial
+///     portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+/// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+/// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+/// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+///
+/// \file summed_area_table.cxx
+/// \brief Summed-area tables over bit planes.
+/// \details This file contains the implementation of the SummedAreaTable class.
+
+#include "raster/summed_area_table.hxx"
+
+#include <algorithm> // for std::max(), std::min()
+#include <bit>       // for std::popcount()
+
+namespace raster {
+
+bool SummedAreaTable::create(const BitPlane &bitPlane) {
+  if (bitPlane.getWidth() == 0 || bitPlane.getHeight() == 0)
+    return false;
+  width = bitPlane.getWidth();
+  height = bitPlane.getHeight();
+  tilesAcross = static_cast<std::size_t>((width + 1 + tileMask) >> tileShift);
+  const std::size_t tilesDown = static_cast<std::size_t>((height + 1 + tileMask) >> tileShift);
+  table.assign((tilesAcross * tilesDown) << (2 * tileShift), 0U);
+  build(bitPlane, 0, 0);
+  return true;
+}
+
+bool SummedAreaTable::update(const BitPlane &bitPlane, int x, int y, int cx, int cy) {
+  if (bitPlane.getWidth() != width || bitPlane.getHeight() != height || table.empty())
+    return false;
+  if (cx <= 0 || cy <= 0 || x >= width || y >= height || x + cx <= 0 || y + cy <= 0)
+    return false;
+  build(bitPlane, std::max(x, 0), std::max(y, 0));
+  return true;
+}
+
+// SummedAreaTable::build(bitPlane, x0, y0)
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Rebuilds entries (x+1, y+1) for all pixels x >= x0 and y >= y0.  Row
+// zero and column zero are always zero.  The running count along scan
+// line y starts from the difference of the two entries at column x0,
+// which the rebuild leaves alone.  Scanning starts at the scan word
+// holding x0; pixels before x0 within that word are skipped.  Each
+// entry within a word adds the population count of the word's bits up
+// to and including its pixel, so no entry tests bits one at a time.
+
+void SummedAreaTable::build(const BitPlane &bitPlane, int x0, int y0) {
+  const std::size_t scanByteCount = (static_cast<std::size_t>(width) + 7U) >> 3;
+  const std::size_t offset0 = static_cast<std::size_t>(x0 >> 6) * sizeof(scanword);
+  for (int y = y0; y < height; ++y) {
+    const scanbyte *scan = bitPlane.bits(0, y);
+    std::uint32_t running = at(x0, y + 1) - at(x0, y);
+    for (std::size_t offset = offset0; offset < scanByteCount; offset += sizeof(scanword)) {
+      const std::size_t count = scanByteCount - offset;
+      const scanword w = loadScanOrder(scan + offset, count < sizeof(scanword) ? count : sizeof(scanword));
+      const int xWord = static_cast<int>(offset * 8U);
+      const int xBegin = std::max(xWord, x0);
+      const int xEnd = std::min(xWord + 64, width);
+      if (w == 0U) {
+        for (int x = xBegin; x < xEnd; ++x)
+          table[index(x + 1, y + 1)] = at(x + 1, y) + running;
+        continue;
+      }
+      // Prefix counts within the word come from popcounts of its leading
+      // bits; base is the running count at the start of the word.
+      const std::uint32_t base =
+          running - (xBegin > xWord ? static_cast<std::uint32_t>(std::popcount(w >> (64 - (xBegin - xWord)))) : 0U);
+      for (int x = xBegin; x < xEnd; ++x) {
+        const auto prefix = static_cast<std::uint32_t>(std::popcount(w >> (63 - (x - xWord))));
+        table[index(x + 1, y + 1)] = at(x + 1, y) + base + prefix;
+      }
+      running = base + static_cast<std::uint32_t>(std::popcount(w >> (63 - (xEnd - 1 - xWord))));
+    }
+  }
+}
+
+std::uint32_t SummedAreaTable::count(int x, int y, int cx, int cy) const {
+  if (table.empty() || cx <= 0 || cy <= 0)
+    return 0U;
+  const int x0 = std::max(x, 0);
+  const int y0 = std::max(y, 0);
+  const int x1 = std::min(x + cx, width);
+  const int y1 = std::min(y + cy, height);
+  if (x0 >= x1 || y0 >= y1)
+    return 0U;
+  return at(x1, y1) - at(x0, y1) - at(x1, y0) + at(x0, y0);
+}
+
+} // namespace raster
@@ -0,0 +1,95 @@
+#include <raster/bit_plane.hxx>
+
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace raster;
+
+namespace {
+
+// Narrow strips sharing scan bytes at their edges, each with its own
+// raster operation and source origin.
+struct Strip {
+  int x;
+  int cx;
+  Rop2 rop2;
+  int xSrc;
+};
+
+// Blits every strip the full height of the plane; threads take strips in
+// turn.
+void blitStrips(BitPlane &bitPlane, const BitPlane &src, const std::vector<Strip> &strips, int threadCount,
+                bool atomic) {
+  const auto blit = [&](int thread) {
+    for (std::size_t i = thread; i < strips.size(); i += threadCount) {
+      const Strip &strip = strips[i];
+      if (atomic)
+        assert(bitPlane.bitBltAtomic(strip.x, 0, strip.cx, bitPlane.getHeight(), src, strip.xSrc, 0, strip.rop2));
+      else
+        assert(bitPlane.bitBlt(strip.x, 0, strip.cx, bitPlane.getHeight(), src, strip.xSrc, 0, strip.rop2));
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int thread = 0; thread < threadCount; ++thread)
+    threads.emplace_back(blit, thread);
+  for (std::thread &thread : threads)
+    thread.join();
+}
+
+} // namespace
+
+// Threads blitting with OR, AND and XOR into strips sharing edge scan
+// bytes, or XOR-ing the same pixels, must agree with a serial run; so
+// must clipped atomic blits.  Other operations refuse atomic blits.
+extern "C" int test_atomic() {
+  std::mt19937 random(53);
+  const int cx = 300;
+  const int cy = 64;
+  const int widthScanBytes = (cx + 7) / 8;
+  std::vector<scanbyte> vSrc(widthScanBytes * cy + 8);
+  for (scanbyte &b : vSrc)
+    b = static_cast<scanbyte>(random());
+  std::vector<scanbyte> vMask(widthScanBytes * cy);
+  for (scanbyte &b : vMask)
+    b = static_cast<scanbyte>(random());
+  const BitPlane src(cx, cy, vSrc.data());
+  const BitPlane mask(cx, cy, vMask.data());
+  const Rop2 rops[] = {srcPaint, srcAnd, srcInvert};
+  for (int i = 0; i < 40; ++i) {
+    std::vector<Strip> strips;
+    for (int x = 0; x < cx;) {
+      const int cxStrip = 1 + static_cast<int>(random() % 5);
+      strips.push_back({x, cxStrip, rops[random() % 3], static_cast<int>(random() % 8)});
+      x += cxStrip;
+    }
+    // Whole-plane XORs overlap every strip and commute with each other.
+    // Unclipped, overlapping blits race on interior scan bytes; a clip
+    // mask makes every store an atomic masked store, so the overlapping
+    // runs attach one themselves.
+    const bool overlap = i % 4 == 3;
+    if (overlap)
+      for (Strip &strip : strips)
+        strip = {0, cx, srcInvert, strip.xSrc};
+    std::vector<scanbyte> vSerial(widthScanBytes * cy);
+    for (scanbyte &b : vSerial)
+      b = static_cast<scanbyte>(random());
+    std::vector<scanbyte> vAtomic(vSerial);
+    BitPlane serial(cx, cy, vSerial.data());
+    BitPlane atomic(cx, cy, vAtomic.data());
+    if (overlap || i % 2 == 1) {
+      serial.setClipMask(&mask);
+      atomic.setClipMask(&mask);
+    }
+    blitStrips(serial, src, strips, 1, false);
+    blitStrips(atomic, src, strips, 8, true);
+    assert(vSerial == vAtomic);
+  }
+  std::vector<scanbyte> v(widthScanBytes * cy);
+  BitPlane bitPlane(cx, cy, v.data());
+  assert(!bitPlane.bitBltAtomic(0, 0, cx, cy, src, 0, 0, srcCopy));
+  std::cout << "atomic blits agree with serial blits" << std::endl;
+  return 0;
+}
@@ -0,0 +1,106 @@
+#include <raster/band_renderer.hxx>
+#include <raster/bit_plane.hxx>
+#include <raster/draw.hxx>
+#include <raster/path.hxx>
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace raster;
+
+// Rendering a display list band by band must match drawing the same
+// operations straight onto the whole page, whatever the band height.
+extern "C" int test_band() {
+  std::mt19937 random(75);
+  const int cx = 77;
+  const int cy = 123;
+  const int scanBytes = (cx + 7) / 8;
+  std::vector<scanbyte> vSrc(scanBytes * 32 + 8);
+  for (scanbyte &b : vSrc)
+    b = static_cast<scanbyte>(random());
+  const BitPlane source(cx, 32, vSrc.data());
+  const Rop2 rops[] = {srcCopy, srcPaint, srcInvert, ropDSna, srcAnd};
+  for (int i = 0; i < 100; ++i) {
+    std::vector<scanbyte> vPage(scanBytes * cy + 8, 0U);
+    BitPlane page(cx, cy, vPage.data());
+    DisplayList displayList;
+    const auto coordinate = [&random](int extent) { return static_cast<int>(random() % (extent + 40)) - 20; };
+    for (int j = 0; j < 30; ++j) {
+      const int x0 = coordinate(cx);
+      const int y0 = coordinate(cy);
+      const int x1 = coordinate(cx);
+      const int y1 = coordinate(cy);
+      const int r = static_cast<int>(random() % 30);
+      const Rop2 rop2 = rops[random() % 5];
+      switch (random() % 8) {
+      case 0:
+        displayList.bitBlt(x0, y0, x1 - x0, y1 - y0, source, 3, 5, rop2);
+        page.bitBlt(x0, y0, x1 - x0, y1 - y0, source, 3, 5, rop2);
+        break;
+      case 1:
+        displayList.bitBlt(x0, y0, x1 - x0, y1 - y0, dstInvert);
+        page.bitBlt(x0, y0, x1 - x0, y1 - y0, dstInvert);
+        break;
+      case 2:
+        displayList.drawLine(x0, y0, x1, y1, rop2);
+        drawLine(page, x0, y0, x1, y1, rop2);
+        break;
+      case 3:
+        displayList.fillRect(x0, y0, x1 - x0, y1 - y0, rop2);
+        fillRect(page, x0, y0, x1 - x0, y1 - y0, rop2);
+        break;
+      case 4:
+        displayList.fillEllipse(x0, y0, r, r / 2, rop2);
+        fillEllipse(page, x0, y0, r, r / 2, rop2);
+        break;
+      case 5:
+        displayList.drawArc(x0, y0, r, r + 3, 30, 200, rop2);
+        drawArc(page, x0, y0, r, r + 3, 30, 200, rop2);
+        break;
+      case 6:
+        displayList.strokeLine(x0, y0, x1, y1, 1 + r / 3, static_cast<LineCap>(r % 3), rop2);
+        strokeLine(page, x0, y0, x1, y1, 1 + r / 3, static_cast<LineCap>(r % 3), rop2);
+        break;
+      default: {
+        Path path;
+        path.moveTo(x0 + 0.25, y0 + 0.75);
+        path.curveTo(x1, y0, x1, y1, x0 + r, y1 - 0.5);
+        path.lineTo(x1 - r, y0 + r);
+        displayList.fillPath(path, FillRule::evenOdd, rop2);
+        fillPath(page, path, FillRule::evenOdd, rop2);
+      }
+      }
+    }
+    BandRenderer renderer(cx, cy, 1 + static_cast<int>(random() % 40));
+    std::vector<scanbyte> vBands(vPage.size(), 0U);
+    int yNext = 0;
+    assert(renderer.render(displayList, [&](const BitPlane &band, int yBand) {
+      assert(yBand == yNext && band.getWidth() == cx);
+      for (int y = 0; y < band.getHeight(); ++y)
+        std::copy_n(band.bits(0, y), scanBytes, vBands.begin() + (yBand + y) * scanBytes);
+      yNext += band.getHeight();
+      return true;
+    }));
+    assert(yNext == cy);
+    for (int y = 0; y < cy; ++y)
+      for (int x = 0; x < cx; ++x) {
+        const scanbyte bit = 0x80U >> (x & 7);
+        assert((vBands[y * scanBytes + (x >> 3)] & bit) == (vPage[y * scanBytes + (x >> 3)] & bit));
+      }
+  }
+
+  // A sink answering false stops rendering.
+  BandRenderer renderer(64, 1000);
+  assert(renderer.getBandHeight() == 1000);
+  BandRenderer narrow(64, 1000, 100);
+  DisplayList displayList;
+  displayList.fillRect(0, 0, 64, 1000);
+  int bands = 0;
+  assert(!narrow.render(displayList, [&bands](const BitPlane &, int) { return ++bands < 3; }));
+  assert(bands == 3);
+  std::cout << "bands match whole pages" << std::endl;
+  return 0;
+}
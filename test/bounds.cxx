@@ -0,0 +1,94 @@
+#include <raster/bounds.hxx>
+#include "pixel.hxx"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace raster;
+
+namespace {
+
+// Brute-force bounding box of the pixels matching set.
+Rect scan(const BitPlane &bitPlane, bool set) {
+  int x0 = bitPlane.getWidth(), y0 = bitPlane.getHeight(), x1 = -1, y1 = -1;
+  for (int y = 0; y < bitPlane.getHeight(); ++y)
+    for (int x = 0; x < bitPlane.getWidth(); ++x)
+      if (pixel(bitPlane, x, y) == set) {
+        x0 = std::min(x0, x);
+        y0 = std::min(y0, y);
+        x1 = std::max(x1, x);
+        y1 = std::max(y1, y);
+      }
+  return x1 < 0 ? Rect{} : Rect{x0, y0, x1 - x0 + 1, y1 - y0 + 1};
+}
+
+// Trimming answers a view whose left edge rounds down to a scan byte.
+void checkTrim(BitPlane &bitPlane, bool set) {
+  const Rect box = scan(bitPlane, set);
+  const BitPlane view = trim(bitPlane, set);
+  if (box.empty()) {
+    assert(view.getWidth() == 0 && view.getHeight() == 0);
+    return;
+  }
+  const int x0 = box.x & ~7;
+  assert(view.getWidth() == box.x + box.cx - x0 && view.getHeight() == box.cy);
+  for (int y = 0; y < view.getHeight(); ++y)
+    for (int x = 0; x < view.getWidth(); ++x)
+      assert(pixel(view, x, y) == pixel(bitPlane, x0 + x, box.y + y));
+}
+
+} // namespace
+
+// Bounding boxes of set and clear pixels must match a brute-force scan
+// over empty, solid, sparse and dense planes of any width, whatever the
+// padding bits beyond the width hold, with or without occupancy.
+extern "C" int test_bounds() {
+  std::mt19937 random(61);
+  for (int i = 0; i < 2000; ++i) {
+    const int cx = 1 + static_cast<int>(random() % 200);
+    const int cy = 1 + static_cast<int>(random() % 40);
+    const int widthScanBytes = (cx + 7) / 8;
+    // Random padding: the scan bytes start random, then the plane is
+    // cleared or filled within its width only.
+    std::vector<scanbyte> v(widthScanBytes * cy + 8);
+    for (scanbyte &b : v)
+      b = static_cast<scanbyte>(random());
+    BitPlane bitPlane(cx, cy, v.data());
+    switch (i % 5) {
+    case 0:
+      bitPlane.bitBlt(0, 0, cx, cy, blackness);
+      break;
+    case 1:
+      bitPlane.bitBlt(0, 0, cx, cy, whiteness);
+      break;
+    case 2:
+    case 3: {
+      // Sparse content on a clear or solid background.
+      const bool background = i % 5 == 3;
+      bitPlane.bitBlt(0, 0, cx, cy, background ? whiteness : blackness);
+      for (int k = static_cast<int>(random() % 4); k > 0; --k)
+        bitPlane.bitBlt(static_cast<int>(random() % cx), static_cast<int>(random() % cy),
+                        1 + static_cast<int>(random() % 9), 1 + static_cast<int>(random() % 3),
+                        background ? blackness : whiteness);
+      break;
+    }
+    default:
+      break;
+    }
+    // Occupancy summaries let the search skip empty scan words; trimming
+    // takes a view, which stops tracking, so bounds come first.
+    if (i % 3 == 0)
+      bitPlane.trackOccupancy();
+    for (const bool set : {true, false})
+      assert(boundingBox(bitPlane, set) == scan(bitPlane, set));
+    for (const bool set : {true, false})
+      checkTrim(bitPlane, set);
+  }
+  BitPlane empty;
+  assert(boundingBox(empty).empty() && boundingBox(empty, false).empty());
+  std::cout << "bounding boxes match a brute-force scan" << std::endl;
+  return 0;
+}
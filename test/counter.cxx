@@ -0,0 +1,75 @@
+#include <raster/bit_sliced_counter.hxx>
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace raster;
+
+// Bit-sliced counts must match plain per-pixel counts, wrapping or
+// saturating, through masked adds, counter adds and thresholds.
+extern "C" int test_counter() {
+  std::mt19937 random(56);
+  const int cx = 100;
+  const int cy = 13;
+  const int widthScanBytes = (cx + 7) / 8;
+  for (const bool saturating : {false, true}) {
+    const int bitCount = 4;
+    const unsigned limit = 1U << bitCount;
+    BitSlicedCounter counter;
+    assert(counter.create(cx, cy, bitCount));
+    counter.setSaturating(saturating);
+    std::vector<unsigned> counts(cx * cy, 0U);
+    const auto addCount = [&](unsigned &count, unsigned value) {
+      count = saturating ? std::min(count + value, limit - 1) : (count + value) % limit;
+    };
+    for (int i = 0; i < 60; ++i) {
+      std::vector<scanbyte> v(widthScanBytes * cy);
+      // Sparse masks exercise the skipped words.
+      for (scanbyte &b : v)
+        b = static_cast<scanbyte>(i % 3 == 0 ? random() & random() & random() : random());
+      const BitPlane mask(cx, cy, v.data());
+      const unsigned value = 1U + random() % 6;
+      assert(value == 1U ? counter.increment(mask) : counter.add(mask, value));
+      for (int y = 0; y < cy; ++y)
+        for (int x = 0; x < cx; ++x)
+          if ((v[y * widthScanBytes + (x >> 3)] & (0x80U >> (x & 7))) != 0)
+            addCount(counts[y * cx + x], value);
+      for (int y = 0; y < cy; ++y)
+        for (int x = 0; x < cx; ++x)
+          assert(counter.count(x, y) == counts[y * cx + x]);
+    }
+
+    // Adding a narrower counter.
+    BitSlicedCounter other;
+    assert(other.create(cx, cy, 2));
+    std::vector<scanbyte> v(widthScanBytes * cy);
+    for (scanbyte &b : v)
+      b = static_cast<scanbyte>(random());
+    const BitPlane mask(cx, cy, v.data());
+    assert(other.add(mask, 3U));
+    assert(counter.add(other));
+    for (int y = 0; y < cy; ++y)
+      for (int x = 0; x < cx; ++x) {
+        addCount(counts[y * cx + x], other.count(x, y));
+        assert(counter.count(x, y) == counts[y * cx + x]);
+      }
+
+    for (unsigned threshold = 0; threshold <= limit; ++threshold) {
+      std::vector<scanbyte> vOut(widthScanBytes * cy, 0x5aU);
+      BitPlane out(cx, cy, vOut.data());
+      assert(counter.threshold(out, threshold));
+      for (int y = 0; y < cy; ++y)
+        for (int x = 0; x < cx; ++x)
+          assert(((vOut[y * widthScanBytes + (x >> 3)] & (0x80U >> (x & 7))) != 0) ==
+                 (counts[y * cx + x] >= threshold));
+    }
+    BitPlane wrong;
+    assert(wrong.create(cx + 1, cy));
+    assert(!counter.increment(wrong));
+  }
+  std::cout << "bit-sliced counts match plain counts" << std::endl;
+  return 0;
+}
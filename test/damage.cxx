@@ -0,0 +1,135 @@
+#include <raster/bit_plane.hxx>
+#include "pixel.hxx"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace raster;
+
+namespace {
+
+// Cells covered by the damage rectangles, asserting that none overlap.
+std::vector<int> cells(const std::vector<Rect> &rects, int cx, int cy, Grain grain) {
+  const int columns = (cx + grain.cx - 1) / grain.cx;
+  std::vector<int> covered(columns * ((cy + grain.cy - 1) / grain.cy), 0);
+  for (const Rect &rect : rects) {
+    assert(!rect.empty() && rect.x % grain.cx == 0 && rect.y % grain.cy == 0);
+    assert(rect.x + rect.cx <= cx && rect.y + rect.cy <= cy);
+    for (int y = rect.y; y < rect.y + rect.cy; y += grain.cy)
+      for (int x = rect.x; x < rect.x + rect.cx; x += grain.cx)
+        assert(++covered[y / grain.cy * columns + x / grain.cx] == 1);
+  }
+  return covered;
+}
+
+// Damage must cover every changed pixel, and only cells meeting the
+// rectangle the operation asked to write.
+void check(const BitPlane &before, BitPlane &after, Grain grain, Rect bound) {
+  if (bound.cx < 0) {
+    bound.x += bound.cx;
+    bound.cx = -bound.cx;
+  }
+  if (bound.cy < 0) {
+    bound.y += bound.cy;
+    bound.cy = -bound.cy;
+  }
+  const int cx = after.getWidth();
+  const int cy = after.getHeight();
+  const int columns = (cx + grain.cx - 1) / grain.cx;
+  const std::vector<int> covered = cells(after.takeDamage(), cx, cy, grain);
+  for (int y = 0; y < cy; ++y)
+    for (int x = 0; x < cx; ++x) {
+      const bool changed = pixel(before, x, y) != pixel(after, x, y);
+      const bool damaged = covered[y / grain.cy * columns + x / grain.cx] != 0;
+      assert(!changed || damaged);
+      if (damaged) {
+        const int x0 = x / grain.cx * grain.cx;
+        const int y0 = y / grain.cy * grain.cy;
+        assert(x0 < bound.x + bound.cx && bound.x < x0 + grain.cx);
+        assert(y0 < bound.y + bound.cy && bound.y < y0 + grain.cy);
+      }
+    }
+  assert(after.takeDamage().empty());
+}
+
+} // namespace
+
+// Damage after blits, fills and row operations must cover every write
+// and nothing far from it; taking or clearing damage empties it.
+extern "C" int test_damage() {
+  std::mt19937 random(63);
+  const auto next = [&](int n) { return static_cast<int>(random() % n); };
+  BitPlane src;
+  assert(src.create(300, 100));
+  for (int y = 0; y < 100; ++y)
+    for (int x = 0; x < 300; x += 8)
+      *src.bits(x, y) = static_cast<scanbyte>(random());
+
+  for (int i = 0; i < 200; ++i) {
+    BitPlane plane;
+    assert(plane.create(1 + next(200), 1 + next(60)));
+    const int cx = plane.getWidth();
+    const int cy = plane.getHeight();
+    assert(plane.bitBlt(0, 0, cx, cy, src, next(100), next(40), srcCopy));
+    const Grain grain{1 + next(20), 1 + next(6)};
+    plane.trackDamage(grain);
+    assert(plane.isTrackingDamage() && plane.takeDamage().empty());
+    BitPlane before;
+    assert(before.create(cx, cy));
+    assert(before.bitBlt(0, 0, cx, cy, plane, 0, 0, srcCopy));
+
+    const Rect rect{next(cx + 20) - 10, next(cy + 20) - 10, next(2 * cx) - cx, next(2 * cy) - cy};
+    switch (i % 4) {
+    case 0:
+      plane.bitBlt(rect.x, rect.y, rect.cx, rect.cy, src, 100 + next(50), 40 + next(20),
+                   static_cast<Rop2>(next(16)));
+      check(before, plane, grain, rect);
+      break;
+    case 1:
+      plane.bitBlt(rect.x, rect.y, rect.cx, rect.cy, i % 8 == 1 ? dstInvert : whiteness);
+      check(before, plane, grain, rect);
+      break;
+    case 2: {
+      assert(plane.indexRows());
+      assert(plane.takeDamage().empty());
+      const int y = next(cy);
+      const int n = 1 + next(4);
+      if (i % 8 == 2) {
+        assert(plane.insertRows(y, n));
+        check(before, plane, grain, {0, y, cx, cy - y});
+      } else {
+        assert(plane.deleteRows(y, n));
+        check(before, plane, grain, {0, y, cx, cy - y});
+      }
+      break;
+    }
+    default: {
+      assert(plane.indexRows());
+      const int y0 = next(cy);
+      const int y1 = next(cy);
+      assert(plane.swapRows(y0, y1));
+      if (y0 == y1)
+        assert(plane.takeDamage().empty());
+      else
+        check(before, plane, grain, {0, std::min(y0, y1), cx, std::abs(y1 - y0) + 1});
+      break;
+    }
+    }
+
+    // Clearing discards damage; re-creating damages everything.
+    assert(plane.bitBlt(0, 0, cx, cy, dstInvert));
+    plane.clearDamage();
+    assert(plane.takeDamage().empty());
+    assert(plane.create(cx, cy));
+    const std::vector<int> covered = cells(plane.takeDamage(), cx, cy, grain);
+    assert(std::all_of(covered.begin(), covered.end(), [](int cell) { return cell == 1; }));
+    plane.untrackDamage();
+    assert(!plane.isTrackingDamage() && plane.takeDamage().empty());
+  }
+  std::cout << "damage covers blits, fills and row operations" << std::endl;
+  return 0;
+}
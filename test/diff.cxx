@@ -0,0 +1,76 @@
+#include <raster/diff.hxx>
+#include "pixel.hxx"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace raster;
+
+// Dirty rectangles must cover exactly the grain cells holding changed
+// pixels, without overlapping, for assorted grains and with or without
+// occupancy summaries; the delta plane must hold the XOR and record
+// the write.
+extern "C" int test_diff() {
+  std::mt19937 random(62);
+  const Grain grains[] = {{}, {16, 4}, {5, 3}, {64, 16}, {1, 1}};
+  for (int i = 0; i < 100; ++i) {
+    const int cx = 1 + static_cast<int>(random() % 200);
+    const int cy = 1 + static_cast<int>(random() % 50);
+    const int widthScanBytes = (cx + 7) / 8;
+    std::vector<scanbyte> vPrevious(widthScanBytes * cy + 8);
+    for (scanbyte &b : vPrevious)
+      b = static_cast<scanbyte>(i % 2 == 0 ? 0U : random());
+    std::vector<scanbyte> vCurrent(vPrevious);
+    BitPlane previous(cx, cy, vPrevious.data());
+    BitPlane current(cx, cy, vCurrent.data());
+    if (i % 3 == 0) {
+      previous.trackOccupancy();
+      current.trackOccupancy();
+    }
+    // A few changes, some in the padding bits beyond the width.
+    for (int k = static_cast<int>(random() % 6); k > 0; --k)
+      current.bitBlt(static_cast<int>(random() % cx), static_cast<int>(random() % cy),
+                     1 + static_cast<int>(random() % 12), 1 + static_cast<int>(random() % 3), dstInvert);
+    vCurrent[widthScanBytes - 1] ^= static_cast<scanbyte>(0xffU >> (cx - 8 * (widthScanBytes - 1)));
+    const auto changed = [&](int x, int y) {
+      const scanbyte bit = 0x80U >> (x & 7);
+      return ((vPrevious[y * widthScanBytes + (x >> 3)] ^ vCurrent[y * widthScanBytes + (x >> 3)]) & bit) != 0;
+    };
+
+    const Grain grain = grains[i % 5];
+    const Grain cell{grain.cx > 0 ? grain.cx : 8, grain.cy > 0 ? grain.cy : 1};
+    BitPlane delta;
+    delta.trackDamage();
+    std::vector<Rect> dirty;
+    assert(frameDiff(previous, current, dirty, grain, &delta));
+    std::vector<int> covered(cx * cy, 0);
+    for (const Rect &rect : dirty) {
+      assert(!rect.empty() && rect.x % cell.cx == 0 && rect.y % cell.cy == 0);
+      for (int y = rect.y; y < rect.y + rect.cy; ++y)
+        for (int x = rect.x; x < rect.x + rect.cx; ++x)
+          ++covered[y * cx + x];
+    }
+    for (int y = 0; y < cy; ++y)
+      for (int x = 0; x < cx; ++x) {
+        bool dirtyCell = false;
+        const int x0 = x / cell.cx * cell.cx;
+        const int y0 = y / cell.cy * cell.cy;
+        for (int yCell = y0; yCell < std::min(y0 + cell.cy, cy); ++yCell)
+          for (int xCell = x0; xCell < std::min(x0 + cell.cx, cx); ++xCell)
+            dirtyCell = dirtyCell || changed(xCell, yCell);
+        assert(covered[y * cx + x] == (dirtyCell ? 1 : 0));
+        assert(pixel(delta, x, y) == changed(x, y));
+      }
+    assert(!delta.takeDamage().empty());
+  }
+  std::vector<Rect> dirty;
+  BitPlane small;
+  BitPlane large;
+  assert(small.create(8, 8) && large.create(16, 8));
+  assert(!frameDiff(small, large, dirty));
+  std::cout << "frame differences cover exactly the changed cells" << std::endl;
+  return 0;
+}
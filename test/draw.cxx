@@ -0,0 +1,132 @@
+#include <raster/bit_plane.hxx>
+#include <raster/draw.hxx>
+#include "pixel.hxx"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace raster;
+
+namespace {
+
+// Reference ink: bit D + 2S of the raster operation where S is one.
+void ink(std::vector<bool> &plane, int cx, int cy, int x, int y, Rop2 rop2) {
+  if (x < 0 || x >= cx || y < 0 || y >= cy)
+    return;
+  plane[y * cx + x] = ((rop2 >> (plane[y * cx + x] ? 3 : 2)) & 1) != 0;
+}
+
+// Reference line: one pixel per major step, stepping the minor axis
+// when the error reaches one half, always from the lesser major end.
+void line(std::vector<bool> &plane, int cx, int cy, int x0, int y0, int x1, int y1, Rop2 rop2) {
+  const bool alongX = std::abs(x1 - x0) >= std::abs(y1 - y0);
+  if (alongX ? x1 < x0 : y1 < y0) {
+    std::swap(x0, x1);
+    std::swap(y0, y1);
+  }
+  const int d = alongX ? x1 - x0 : y1 - y0;
+  const int m = std::abs(alongX ? y1 - y0 : x1 - x0);
+  const int s = (alongX ? y1 < y0 : x1 < x0) ? -1 : 1;
+  int minor = 0;
+  int error = d;
+  for (int k = 0; k <= d; ++k) {
+    if (alongX)
+      ink(plane, cx, cy, x0 + k, y0 + s * minor, rop2);
+    else
+      ink(plane, cx, cy, x0 + s * minor, y0 + k, rop2);
+    error += 2 * m;
+    if (error >= 2 * d) {
+      error -= 2 * d;
+      ++minor;
+    }
+  }
+}
+
+} // namespace
+
+// Spans, columns, lines and rectangles must match pixel-by-pixel
+// references with every ink, clip to the plane and the clip mask, and
+// draw lines the same in either direction.
+extern "C" int test_draw() {
+  std::mt19937 random(72);
+  const Rop2 rops[] = {srcCopy, srcPaint, ropDSna, srcInvert, notSrcCopy};
+  for (int i = 0; i < 3000; ++i) {
+    const int cx = 1 + static_cast<int>(random() % 200);
+    const int cy = 1 + static_cast<int>(random() % 40);
+    std::vector<scanbyte> v(((cx + 7) / 8) * cy);
+    for (scanbyte &b : v)
+      b = static_cast<scanbyte>(random());
+    std::vector<scanbyte> vMask(v.size());
+    for (scanbyte &b : vMask)
+      b = static_cast<scanbyte>(random());
+    BitPlane bitPlane(cx, cy, v.data());
+    const BitPlane mask(cx, cy, vMask.data());
+    const bool clipping = random() % 4 == 0;
+    if (clipping)
+      bitPlane.setClipMask(&mask);
+    std::vector<bool> expected(cx * cy);
+    for (int y = 0; y < cy; ++y)
+      for (int x = 0; x < cx; ++x)
+        expected[y * cx + x] = pixel(bitPlane, x, y);
+    const Rop2 rop2 = rops[random() % 5];
+    const int x0 = static_cast<int>(random() % (cx + 40)) - 20;
+    const int y0 = static_cast<int>(random() % (cy + 40)) - 20;
+    const int x1 = static_cast<int>(random() % (cx + 40)) - 20;
+    const int y1 = static_cast<int>(random() % (cy + 40)) - 20;
+    std::vector<bool> drawn(cx * cy);
+    switch (random() % 5) {
+    case 0:
+      drawSpan(bitPlane, x0, y0, x1 - x0, rop2);
+      for (int x = x0; x < x1; ++x)
+        ink(drawn, cx, cy, x, y0, ropDSo);
+      break;
+    case 1:
+      drawVLine(bitPlane, x0, y0, y1 - y0, rop2);
+      for (int y = y0; y < y1; ++y)
+        ink(drawn, cx, cy, x0, y, ropDSo);
+      break;
+    case 2:
+      drawLine(bitPlane, x0, y0, x1, y1, rop2);
+      line(drawn, cx, cy, x0, y0, x1, y1, ropDSo);
+      break;
+    case 3:
+      drawRect(bitPlane, x0, y0, x1 - x0, y1 - y0, rop2);
+      for (int y = y0; y < y1; ++y)
+        for (int x = x0; x < x1; ++x)
+          if (y == y0 || y == y1 - 1 || x == x0 || x == x1 - 1)
+            ink(drawn, cx, cy, x, y, ropDSo);
+      break;
+    default:
+      fillRect(bitPlane, x0, y0, x1 - x0, y1 - y0, rop2);
+      for (int y = y0; y < y1; ++y)
+        for (int x = x0; x < x1; ++x)
+          ink(drawn, cx, cy, x, y, ropDSo);
+    }
+    for (int y = 0; y < cy; ++y)
+      for (int x = 0; x < cx; ++x) {
+        if (drawn[y * cx + x] && (!clipping || pixel(mask, x, y)))
+          ink(expected, cx, cy, x, y, rop2);
+        assert(pixel(bitPlane, x, y) == expected[y * cx + x]);
+      }
+  }
+
+  // Inverting a line from either end restores the plane.
+  std::vector<scanbyte> v(8 * 64, 0U);
+  BitPlane bitPlane(64, 64, v.data());
+  for (int i = 0; i < 1000; ++i) {
+    const int x0 = static_cast<int>(random() % 80) - 8;
+    const int y0 = static_cast<int>(random() % 80) - 8;
+    const int x1 = static_cast<int>(random() % 80) - 8;
+    const int y1 = static_cast<int>(random() % 80) - 8;
+    drawLine(bitPlane, x0, y0, x1, y1, srcInvert);
+    drawLine(bitPlane, x1, y1, x0, y0, srcInvert);
+    assert(std::all_of(v.begin(), v.end(), [](scanbyte b) { return b == 0U; }));
+  }
+  std::cout << "drawing matches pixel drawing" << std::endl;
+  return 0;
+}
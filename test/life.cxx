@@ -0,0 +1,77 @@
+#include <raster/neighbourhood.hxx>
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace raster;
+
+namespace {
+
+bool pixel(const BitPlane &bitPlane, int x, int y, Edge edge) {
+  const int cx = bitPlane.getWidth();
+  const int cy = bitPlane.getHeight();
+  if (x < 0 || x >= cx || y < 0 || y >= cy) {
+    if (edge == edgeZero)
+      return false;
+    if (edge == edgeWrap) {
+      x = (x + cx) % cx;
+      y = (y + cy) % cy;
+    } else {
+      x = x < 0 ? 0 : x >= cx ? cx - 1 : x;
+      y = y < 0 ? 0 : y >= cy ? cy - 1 : y;
+    }
+  }
+  return (*bitPlane.bits(x, y) & (0x80U >> (x & 7))) != 0;
+}
+
+} // namespace
+
+extern "C" int test_life() {
+  // One Life generation on a random plane, every edge treatment, checked
+  // against a pixel-by-pixel count. The width spans two scan words with
+  // a ragged end.
+  const int cx = 131;
+  const int cy = 45;
+  const int widthScanBytes = (cx + 7) / 8;
+  std::mt19937 random(57);
+  std::vector<scanbyte> vSrc(widthScanBytes * cy);
+  for (scanbyte &v : vSrc)
+    v = static_cast<scanbyte>(random());
+  BitPlane imageSrc(cx, cy, vSrc.data());
+  BitPlane image;
+  assert(image.create(cx, cy));
+  const NeighbourRule rule = NeighbourRule::life();
+  for (Edge edge : {edgeZero, edgeClamp, edgeWrap}) {
+    assert(neighbourhood(execution::parallel_policy{64}, image, imageSrc, rule, edge));
+    for (int y = 0; y < cy; ++y)
+      for (int x = 0; x < cx; ++x) {
+        int count = 0;
+        for (int dy = -1; dy <= 1; ++dy)
+          for (int dx = -1; dx <= 1; ++dx)
+            count += (dx != 0 || dy != 0) && pixel(imageSrc, x + dx, y + dy, edge);
+        const bool alive = pixel(imageSrc, x, y, edge);
+        const bool expect = alive ? (rule.survival >> count) & 1U : (rule.birth >> count) & 1U;
+        assert(pixel(image, x, y, edgeZero) == expect);
+      }
+  }
+  assert(!neighbourhood(image, image, rule));
+
+  // A glider on a 16-by-16 torus returns to its starting pattern after
+  // 64 generations.
+  scanbyte vGlider[32] = {0x40U, 0x00U, 0x20U, 0x00U, 0xe0U};
+  scanbyte vStart[32];
+  std::copy(std::begin(vGlider), std::end(vGlider), std::begin(vStart));
+  BitPlane glider(16, 16, vGlider);
+  BitPlane next;
+  assert(next.create(16, 16));
+  for (int generation = 0; generation < 64; ++generation) {
+    assert(neighbourhood(next, glider, rule, edgeWrap));
+    glider.bitBlt(0, 0, 16, 16, next, 0, 0, srcCopy);
+  }
+  assert(std::equal(std::begin(vGlider), std::end(vGlider), std::begin(vStart)));
+  std::cout << "neighbourhood rule matches pixel counts" << std::endl;
+  return 0;
+}
@@ -0,0 +1,131 @@
+#include <raster/bounds.hxx>
+#include <raster/diff.hxx>
+#include <raster/pixels.hxx>
+#include "pixel.hxx"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace raster;
+
+namespace {
+
+// The settled summary must match the scan bytes exactly: every scan
+// word and scan line with a set pixel inside the width, and no others.
+void check(const BitPlane &bitPlane) {
+  const int cx = bitPlane.getWidth();
+  const int cy = bitPlane.getHeight();
+  int next = cy;
+  for (int y = cy - 1; y >= 0; --y) {
+    bool row = false;
+    for (int x0 = 0; x0 < cx; x0 += 64) {
+      bool word = false;
+      for (int x = x0; x < std::min(x0 + 64, cx); ++x)
+        word = word || pixel(bitPlane, x, y);
+      assert(bitPlane.isWordOccupied(y, x0 >> 3) == word);
+      row = row || word;
+    }
+    assert(bitPlane.isRowOccupied(y) == row);
+    if (row)
+      next = y;
+    assert(bitPlane.nextOccupiedRow(y) == next);
+  }
+}
+
+} // namespace
+
+// Occupancy summaries must follow blits, fills, shifts and row
+// operations exactly; views and static copies must not leave a stale
+// summary behind.
+extern "C" int test_occupancy() {
+  std::mt19937 random(66);
+  const auto next = [&](int n) { return static_cast<int>(random() % n); };
+  BitPlane src;
+  assert(src.create(400, 120));
+  assert(src.bitBlt(0, 0, 400, 120, blackness));
+  for (int k = 0; k < 60; ++k)
+    assert(src.bitBlt(next(400), next(120), 1 + next(20), 1 + next(3), whiteness));
+
+  for (int i = 0; i < 100; ++i) {
+    BitPlane plane;
+    assert(plane.create(1 + next(300), 1 + next(80)));
+    const int cx = plane.getWidth();
+    const int cy = plane.getHeight();
+    assert(plane.bitBlt(0, 0, cx, cy, src, next(100), next(40), srcCopy));
+    plane.trackOccupancy();
+    assert(plane.isTrackingOccupancy());
+    check(plane);
+    if (i % 2 == 0)
+      assert(plane.indexRows());
+    for (int k = 0; k < 10; ++k) {
+      const int x = next(cx);
+      const int y = next(cy);
+      switch (next(6)) {
+      case 0:
+        plane.bitBlt(x, y, next(80), next(10), src, next(400), next(120), static_cast<Rop2>(next(16)));
+        break;
+      case 1:
+        plane.bitBlt(x, y, next(80), next(10), next(2) == 0 ? blackness : whiteness);
+        break;
+      case 2:
+        plane.shiftBits(0, y, cx, next(10), next(40) - 20, next(2) == 0);
+        break;
+      case 3:
+        plane.scrollRows(next(cy));
+        break;
+      case 4:
+        plane.insertRows(y, 1 + next(3));
+        break;
+      default:
+        plane.swapRows(y, next(cy));
+        break;
+      }
+      check(plane);
+    }
+  }
+
+  // Writing through a view stops the plane trusting its summary, so
+  // blits from it, bounds, pixels and frame differences see the write.
+  BitPlane a;
+  BitPlane b;
+  assert(a.create(128, 64) && b.create(128, 64));
+  assert(a.bitBlt(0, 0, 128, 64, blackness) && b.bitBlt(0, 0, 128, 64, blackness));
+  a.trackOccupancy();
+  b.trackOccupancy();
+  assert(a.view(0, 0, 128, 64).bitBlt(70, 20, 3, 2, whiteness));
+  assert(!a.isTrackingOccupancy());
+  const Rect box = boundingBox(a);
+  assert(box.x == 70 && box.y == 20 && box.cx == 3 && box.cy == 2);
+  assert(nextSet(a, 0, 20) == 70);
+  std::vector<Rect> dirty;
+  assert(frameDiff(b, a, dirty) && !dirty.empty());
+  assert(b.bitBlt(0, 0, 128, 64, a, 0, 0, srcCopy));
+  assert(pixel(b, 70, 20) && pixel(b, 72, 21) && !pixel(b, 73, 21));
+  check(b);
+  a.trackOccupancy();
+  check(a);
+
+  // A static copy shares scan bytes without the summary; the original
+  // sees writes through the copy once touched.
+  std::vector<scanbyte> v(16 * 64 + 8, 0U);
+  BitPlane original(128, 64, v.data());
+  original.trackOccupancy();
+  original.trackDamage();
+  BitPlane copy(original);
+  assert(!copy.isTrackingOccupancy() && original.isTrackingOccupancy());
+  assert(copy.bitBlt(10, 10, 5, 5, whiteness));
+  assert(boundingBox(copy) == (Rect{10, 10, 5, 5}));
+  assert(original.takeDamage().empty());
+  original.touch(10, 10, 5, 5);
+  assert(boundingBox(original) == (Rect{10, 10, 5, 5}));
+  check(original);
+  assert(!original.takeDamage().empty());
+  BitPlane deep(a);
+  assert(deep.isTrackingOccupancy());
+  check(deep);
+  std::cout << "occupancy summaries follow every write" << std::endl;
+  return 0;
+}
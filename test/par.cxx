@@ -0,0 +1,39 @@
+#include <raster/bit_plane.hxx>
+
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace raster;
+
+extern "C" int test_par() {
+  // Blit a random source into two identical destinations, one sequenced
+  // and one parallel, then compare the destinations bit for bit. A tiny
+  // grain forces many bands even for a small plane.
+  const int cx = 203;
+  const int cy = 97;
+  const int widthScanBytes = (cx + 7) / 8;
+  std::mt19937 random(51);
+  std::vector<scanbyte> vSrc(widthScanBytes * cy);
+  for (scanbyte &v : vSrc)
+    v = static_cast<scanbyte>(random());
+  std::vector<scanbyte> vSeq(vSrc.rbegin(), vSrc.rend());
+  std::vector<scanbyte> vPar(vSeq);
+  BitPlane imageSrc(cx, cy, vSrc.data());
+  BitPlane imageSeq(cx, cy, vSeq.data());
+  BitPlane imagePar(cx, cy, vPar.data());
+  const execution::parallel_policy fine{64};
+
+  for (int rop2 = rop0; rop2 < ropMax; ++rop2) {
+    assert(imageSeq.bitBlt(execution::seq, 3, 5, 190, 80, imageSrc, 11, 2, Rop2(rop2)));
+    assert(imagePar.bitBlt(fine, 3, 5, 190, 80, imageSrc, 11, 2, Rop2(rop2)));
+    assert(vSeq == vPar);
+  }
+  assert(imageSeq.bitBlt(execution::seq, -7, 1, 100, 200, dstInvert));
+  assert(imagePar.bitBlt(execution::par_unseq, -7, 1, 100, 200, dstInvert));
+  assert(vSeq == vPar);
+  assert(!imagePar.bitBlt(execution::par, cx, 0, 8, 8, imageSrc, 0, 0, srcCopy));
+  std::cout << "parallel and sequenced blits agree" << std::endl;
+  return 0;
+}
@@ -0,0 +1,126 @@
+#include <raster/bit_plane.hxx>
+#include <raster/draw.hxx>
+#include <raster/path.hxx>
+#include "pixel.hxx"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace raster;
+
+namespace {
+
+int firstCentre(double value) { return static_cast<int>(std::ceil(value - 0.5)); }
+
+struct Vertex {
+  double x;
+  double y;
+};
+
+// Reference winding number at the centre of pixel x, y: the windings of
+// the edges crossing scan line y at or left of the pixel.
+int winding(const std::vector<std::vector<Vertex>> &polygons, int x, int y) {
+  int sum = 0;
+  for (const std::vector<Vertex> &polygon : polygons)
+    for (std::size_t i = 0; i < polygon.size(); ++i) {
+      Vertex v0 = polygon[i];
+      Vertex v1 = polygon[(i + 1) % polygon.size()];
+      int w = 1;
+      if (v1.y < v0.y) {
+        std::swap(v0, v1);
+        w = -1;
+      }
+      if (y < firstCentre(v0.y) || y >= firstCentre(v1.y))
+        continue;
+      const double xCross = v0.x + (y + 0.5 - v0.y) * ((v1.x - v0.x) / (v1.y - v0.y));
+      if (firstCentre(xCross) <= x)
+        sum += w;
+    }
+  return sum;
+}
+
+} // namespace
+
+// Path filling must match a pixel-centre winding reference under both
+// fill rules, and filling band by band must match filling the whole.
+extern "C" int test_path() {
+  std::mt19937 random(73);
+  for (int i = 0; i < 500; ++i) {
+    const int cx = 1 + static_cast<int>(random() % 100);
+    const int cy = 1 + static_cast<int>(random() % 60);
+    std::vector<std::vector<Vertex>> polygons(1 + random() % 3);
+    Path path;
+    for (std::vector<Vertex> &polygon : polygons) {
+      polygon.resize(3 + random() % 8);
+      for (Vertex &vertex : polygon) {
+        vertex.x = static_cast<int>(random() % ((cx + 20) * 4)) / 4.0 - 10;
+        vertex.y = static_cast<int>(random() % ((cy + 20) * 4)) / 4.0 - 10;
+      }
+      path.moveTo(polygon.front().x, polygon.front().y);
+      for (std::size_t j = 1; j < polygon.size(); ++j)
+        path.lineTo(polygon[j].x, polygon[j].y);
+      if (random() % 2 == 0)
+        path.close();
+    }
+    const FillRule fillRule = random() % 2 == 0 ? FillRule::evenOdd : FillRule::nonZero;
+    std::vector<scanbyte> v(((cx + 7) / 8) * cy, 0U);
+    BitPlane bitPlane(cx, cy, v.data());
+    fillPath(bitPlane, path, fillRule, srcCopy);
+    for (int y = 0; y < cy; ++y)
+      for (int x = 0; x < cx; ++x) {
+        const int w = winding(polygons, x, y);
+        assert(pixel(bitPlane, x, y) == (fillRule == FillRule::evenOdd ? (w & 1) != 0 : w != 0));
+      }
+
+    const int cyBand = 1 + static_cast<int>(random() % 16);
+    std::vector<scanbyte> vBand(((cx + 7) / 8) * cyBand);
+    for (int yBand = 0; yBand < cy; yBand += cyBand) {
+      std::fill(vBand.begin(), vBand.end(), 0U);
+      BitPlane band(cx, std::min(cyBand, cy - yBand), vBand.data());
+      fillPath(band, path, fillRule, srcCopy, yBand);
+      for (int y = 0; y < band.getHeight(); ++y)
+        for (int x = 0; x < cx; ++x)
+          assert(pixel(band, x, y) == pixel(bitPlane, x, yBand + y));
+    }
+  }
+
+  // Integer rectangles fill as fillRect() fills; curves stay in bounds.
+  std::vector<scanbyte> v(8 * 64, 0U);
+  std::vector<scanbyte> vRect(8 * 64, 0U);
+  BitPlane bitPlane(64, 64, v.data());
+  BitPlane rect(64, 64, vRect.data());
+  Path path;
+  path.moveTo(5, 7);
+  path.lineTo(40, 7);
+  path.lineTo(40, 30);
+  path.lineTo(5, 30);
+  assert(fillPath(bitPlane, path));
+  fillRect(rect, 5, 7, 35, 23);
+  assert(v == vRect);
+  path.clear();
+  std::fill(v.begin(), v.end(), 0U);
+  const double k = 0.5523 * 20;
+  path.moveTo(32, 12);
+  path.curveTo(32 + k, 12, 52, 32 - k, 52, 32);
+  path.curveTo(52, 32 + k, 32 + k, 52, 32, 52);
+  path.curveTo(32 - k, 52, 12, 32 + k, 12, 32);
+  path.curveTo(12, 32 - k, 32 - k, 12, 32, 12);
+  assert(fillPath(bitPlane, path, FillRule::evenOdd));
+  const Rect bounds = path.bounds();
+  assert(bounds.x == 12 && bounds.y == 12 && bounds.cx == 40 && bounds.cy == 40);
+  int count = 0;
+  for (int y = 0; y < 64; ++y)
+    for (int x = 0; x < 64; ++x)
+      if (pixel(bitPlane, x, y)) {
+        assert(bounds.x <= x && x < bounds.x + bounds.cx && bounds.y <= y && y < bounds.y + bounds.cy);
+        ++count;
+      }
+  assert(std::abs(count - 1257) < 40);
+  std::cout << "paths fill by winding" << std::endl;
+  return 0;
+}
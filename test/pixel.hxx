@@ -0,0 +1,8 @@
+#pragma once
+
+#include <raster/bit_plane.hxx>
+
+// Answers true if pixel (x, y) of a plane is set.
+inline bool pixel(const raster::BitPlane &bitPlane, int x, int y) {
+  return (*bitPlane.bits(x, y) & (0x80U >> (x & 7))) != 0;
+}
@@ -0,0 +1,84 @@
+#include <raster/pixels.hxx>
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace raster;
+
+// Pixel and run iterators, searches and extractors, sequential and
+// parallel, must agree with a brute-force scan.  Runs crossing scan
+// word boundaries must come out whole.
+extern "C" int test_pixels() {
+  std::mt19937 random(60);
+  const execution::parallel_policy fine{1};
+  for (int i = 0; i < 100; ++i) {
+    const int cx = 1 + static_cast<int>(random() % 300);
+    const int cy = 1 + static_cast<int>(random() % 20);
+    const int widthScanBytes = (cx + 7) / 8;
+    std::vector<scanbyte> v(widthScanBytes * cy + 8);
+    // Sparse, dense and solid planes.
+    for (scanbyte &b : v)
+      b = static_cast<scanbyte>(i % 3 == 0 ? random() & random() & random() : i % 3 == 1 ? random() | random() : 0xffU);
+    BitPlane bitPlane(cx, cy, v.data());
+    if (i % 3 == 2)
+      bitPlane.bitBlt(cx / 3, 0, cx / 4, cy, blackness);
+    const auto pixel = [&](int x, int y) { return (v[y * widthScanBytes + (x >> 3)] & (0x80U >> (x & 7))) != 0; };
+
+    std::vector<Point> points;
+    std::vector<Run> runs;
+    for (int y = 0; y < cy; ++y)
+      for (int x = 0; x < cx; ++x)
+        if (pixel(x, y)) {
+          points.push_back({x, y});
+          if (x == 0 || !pixel(x - 1, y))
+            runs.push_back({y, x, x + 1});
+          else
+            ++runs.back().x1;
+        }
+
+    assert(std::equal(points.begin(), points.end(), SetPixels(bitPlane).begin(), SetPixels(bitPlane).end()));
+    assert(std::equal(runs.begin(), runs.end(), SetRuns(bitPlane).begin(), SetRuns(bitPlane).end()));
+    for (int k = 0; k < 20; ++k) {
+      const int x = static_cast<int>(random() % (cx + 1));
+      const int y = static_cast<int>(random() % cy);
+      int set = x;
+      while (set < cx && !pixel(set, y))
+        ++set;
+      int clear = x;
+      while (clear < cx && pixel(clear, y))
+        ++clear;
+      assert(nextSet(bitPlane, x, y) == set);
+      assert(nextClear(bitPlane, x, y) == clear);
+    }
+
+    // Full buffers, then buffers too small by some.
+    for (const std::size_t capacity : {points.size(), points.size() / 2}) {
+      std::vector<int> xs(capacity, -1);
+      std::vector<int> ys(capacity, -1);
+      assert(extractPixels(bitPlane, {xs, ys}) == points.size());
+      for (std::size_t k = 0; k < capacity; ++k)
+        assert(xs[k] == points[k].x && ys[k] == points[k].y);
+      std::fill(xs.begin(), xs.end(), -1);
+      assert(extractPixels(fine, bitPlane, {xs, ys}) == points.size());
+      for (std::size_t k = 0; k < capacity; ++k)
+        assert(xs[k] == points[k].x && ys[k] == points[k].y);
+    }
+    for (const std::size_t capacity : {runs.size(), runs.size() / 2}) {
+      std::vector<int> ys(capacity, -1);
+      std::vector<int> x0s(capacity, -1);
+      std::vector<int> x1s(capacity, -1);
+      assert(extractRuns(execution::seq, bitPlane, {ys, x0s, x1s}) == runs.size());
+      for (std::size_t k = 0; k < capacity; ++k)
+        assert((Run{ys[k], x0s[k], x1s[k]} == runs[k]));
+      std::fill(x0s.begin(), x0s.end(), -1);
+      assert(extractRuns(fine, bitPlane, {ys, x0s, x1s}) == runs.size());
+      for (std::size_t k = 0; k < capacity; ++k)
+        assert((Run{ys[k], x0s[k], x1s[k]} == runs[k]));
+    }
+  }
+  std::cout << "pixel and run enumeration matches a brute-force scan" << std::endl;
+  return 0;
+}
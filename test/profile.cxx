@@ -0,0 +1,54 @@
+#include <raster/profile.hxx>
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace raster;
+
+// Row and column profiles of sub-rectangles, including rectangles
+// hanging off the plane, must match brute-force counts.
+extern "C" int test_profile() {
+  std::mt19937 random(59);
+  for (int i = 0; i < 200; ++i) {
+    const int cx = 1 + static_cast<int>(random() % 300);
+    const int cy = 1 + static_cast<int>(random() % 30);
+    const int widthScanBytes = (cx + 7) / 8;
+    std::vector<scanbyte> v(widthScanBytes * cy + 8);
+    for (scanbyte &b : v)
+      b = static_cast<scanbyte>(i % 2 == 0 ? random() : random() & random() & random());
+    const BitPlane bitPlane(cx, cy, v.data());
+    const auto pixel = [&](int x, int y) {
+      return 0 <= x && x < cx && 0 <= y && y < cy && (v[y * widthScanBytes + (x >> 3)] & (0x80U >> (x & 7))) != 0;
+    };
+    const int x = static_cast<int>(random() % (cx + 20)) - 10;
+    const int y = static_cast<int>(random() % (cy + 20)) - 10;
+    const int cxRect = 1 + static_cast<int>(random() % (cx + 20));
+    const int cyRect = 1 + static_cast<int>(random() % (cy + 20));
+    const bool hits = x < cx && y < cy && x + cxRect > 0 && y + cyRect > 0;
+
+    std::vector<std::uint32_t> rows(cyRect, 0xdeadU);
+    assert(rowProfile(bitPlane, x, y, cxRect, cyRect, rows) == hits);
+    if (hits)
+      for (int row = 0; row < cyRect; ++row) {
+        std::uint32_t count = 0U;
+        for (int column = 0; column < cxRect; ++column)
+          count += pixel(x + column, y + row) ? 1U : 0U;
+        assert(rows[row] == count);
+      }
+
+    std::vector<std::uint32_t> columns(cxRect, 0xdeadU);
+    assert(columnProfile(bitPlane, x, y, cxRect, cyRect, columns) == hits);
+    if (hits)
+      for (int column = 0; column < cxRect; ++column) {
+        std::uint32_t count = 0U;
+        for (int row = 0; row < cyRect; ++row)
+          count += pixel(x + column, y + row) ? 1U : 0U;
+        assert(columns[column] == count);
+      }
+  }
+  std::cout << "profiles match brute-force counts" << std::endl;
+  return 0;
+}
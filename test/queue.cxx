@@ -0,0 +1,105 @@
+#include <raster/blit_queue.hxx>
+
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+using namespace raster;
+
+namespace {
+
+// Minimal fire-and-forget coroutine for awaiting blit-queue work.
+struct Detached {
+  struct promise_type {
+    Detached get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+Detached invertTwice(BlitQueue &queue, BitPlane &image, std::promise<bool> &done) {
+  bool inverted = co_await queue.schedule(image, [](BitPlane &bitPlane) {
+    return bitPlane.bitBlt(0, 0, bitPlane.getWidth(), bitPlane.getHeight(), dstInvert);
+  });
+  inverted = inverted && co_await queue.schedule(image, [](BitPlane &bitPlane) {
+    return bitPlane.bitBlt(0, 0, bitPlane.getWidth(), bitPlane.getHeight(), dstInvert);
+  });
+  done.set_value(inverted);
+}
+
+Detached awaitThrow(BlitQueue &queue, BitPlane &image, std::promise<bool> &done) {
+  bool caught = false;
+  try {
+    co_await queue.schedule(image, [](BitPlane &) -> bool { throw std::runtime_error("work"); });
+  } catch (const std::runtime_error &) {
+    caught = true;
+  }
+  done.set_value(caught);
+}
+
+// Waiting for the queue after resuming must not wait for the resumed
+// work itself.
+Detached awaitThenWait(BlitQueue &queue, BitPlane &image, std::promise<bool> &done) {
+  bool result = co_await queue.schedule(image, [](BitPlane &) { return true; });
+  queue.wait();
+  done.set_value(result);
+}
+
+} // namespace
+
+extern "C" int test_queue() {
+  // Submission order per plane: fill white, then clear a stripe, then
+  // invert everything. Any other order gives a different image. Several
+  // planes progress at once on a pool of workers.
+  const int cx = 64;
+  const int cy = 64;
+  std::vector<std::vector<scanbyte>> stores(8, std::vector<scanbyte>(cx / 8 * cy, 0x5aU));
+  std::vector<BitPlane> images;
+  images.reserve(stores.size());
+  for (std::vector<scanbyte> &store : stores)
+    images.emplace_back(cx, cy, store.data());
+  std::vector<std::future<bool>> futures;
+  {
+    BlitQueue queue(4U);
+    for (BitPlane &image : images) {
+      futures.push_back(queue.bitBlt(image, 0, 0, cx, cy, whiteness));
+      futures.push_back(queue.bitBlt(image, 0, 8, cx, 8, blackness));
+      futures.push_back(queue.bitBlt(image, 0, 0, cx, cy, dstInvert));
+    }
+    queue.wait();
+    for (std::future<bool> &future : futures)
+      assert(future.get());
+
+    std::promise<bool> done;
+    std::future<bool> doneFuture = done.get_future();
+    invertTwice(queue, images[0], done);
+    assert(doneFuture.get());
+
+    // Work throwing rethrows where the result arrives, not on the worker.
+    std::future<bool> thrown = queue.submit(images[1], [](BitPlane &) -> bool { throw std::runtime_error("work"); });
+    bool caught = false;
+    try {
+      thrown.get();
+    } catch (const std::runtime_error &) {
+      caught = true;
+    }
+    assert(caught);
+    std::promise<bool> rethrown;
+    std::future<bool> rethrownFuture = rethrown.get_future();
+    awaitThrow(queue, images[1], rethrown);
+    assert(rethrownFuture.get());
+    std::promise<bool> waited;
+    std::future<bool> waitedFuture = waited.get_future();
+    awaitThenWait(queue, images[2], waited);
+    assert(waitedFuture.get());
+  }
+  for (const std::vector<scanbyte> &store : stores)
+    for (int y = 0; y < cy; ++y)
+      for (int i = 0; i < cx / 8; ++i)
+        assert(store[y * cx / 8 + i] == (8 <= y && y < 16 ? 0xffU : 0x00U));
+  std::cout << "blit queue keeps per-plane order" << std::endl;
+  return 0;
+}
@@ -0,0 +1,73 @@
+#include <raster/reduce.hxx>
+
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace raster;
+
+extern "C" int test_reduce() {
+  // Reduce nine random planes every way and check every bit against a
+  // straightforward count. The width exercises scan words, trailing scan
+  // bytes and a partial last scan byte.
+  const int cx = 150;
+  const int cy = 13;
+  const int widthScanBytes = (cx + 7) / 8;
+  const int n = 9;
+  std::mt19937 random(55);
+  std::vector<std::vector<scanbyte>> stores(n, std::vector<scanbyte>(widthScanBytes * cy));
+  std::vector<BitPlane> planes;
+  std::vector<const BitPlane *> operands;
+  planes.reserve(n);
+  for (std::vector<scanbyte> &store : stores) {
+    for (scanbyte &v : store)
+      v = static_cast<scanbyte>(random() & random());
+    planes.emplace_back(cx, cy, store.data());
+    operands.push_back(&planes.back());
+  }
+  std::vector<scanbyte> vOut(widthScanBytes * cy, 0x01U);
+  BitPlane out(cx, cy, vOut.data());
+
+  const struct {
+    Reduction reduction;
+    int k;
+  } cases[] = {{reduceOr, 0},      {reduceAnd, 0},     {reduceXor, 0},     {reduceAtLeast, 0},
+               {reduceAtLeast, 3}, {reduceAtLeast, 8}, {reduceAtLeast, 9}, {reduceMajority, 0}};
+  for (const auto &c : cases) {
+    assert(reduce(execution::parallel_policy{16}, out, operands, c.reduction, c.k));
+    for (int y = 0; y < cy; ++y)
+      for (int x = 0; x < cx; ++x) {
+        const scanbyte bit = 0x80U >> (x & 7);
+        int count = 0;
+        for (const BitPlane &plane : planes)
+          count += (*plane.bits(x, y) & bit) != 0;
+        bool expect = false;
+        switch (c.reduction) {
+        case reduceOr:
+          expect = count > 0;
+          break;
+        case reduceAnd:
+          expect = count == n;
+          break;
+        case reduceXor:
+          expect = count & 1;
+          break;
+        case reduceAtLeast:
+          expect = count >= c.k;
+          break;
+        case reduceMajority:
+          expect = count > n / 2;
+          break;
+        }
+        assert(((*out.bits(x, y) & bit) != 0) == expect);
+      }
+    // Padding bits beyond the width stay put.
+    for (int y = 0; y < cy; ++y)
+      assert((*out.bits(cx - 1, y) & 0x01U) == 0x01U);
+  }
+  BitPlane narrow(cx - 1, cy, vOut.data());
+  assert(!reduce(narrow, operands, reduceOr));
+  std::cout << "reductions match bit counts" << std::endl;
+  return 0;
+}
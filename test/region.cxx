@@ -0,0 +1,113 @@
+#include <raster/bit_plane.hxx>
+#include <raster/region.hxx>
+#include "pixel.hxx"
+
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace raster;
+
+namespace {
+
+const int n = 40;
+
+// Pixel membership of a region, checking the rectangles stay inside the
+// grid and never overlap.
+std::vector<char> pixels(const Region &region) {
+  std::vector<char> in(n * n, 0);
+  for (const Rect &rect : region.getRects())
+    for (int y = rect.y; y < rect.y + rect.cy; ++y)
+      for (int x = rect.x; x < rect.x + rect.cx; ++x) {
+        assert(0 <= x && x < n && 0 <= y && y < n);
+        assert(in[y * n + x] == 0);
+        in[y * n + x] = 1;
+      }
+  return in;
+}
+
+// Banded Y-X order: rectangles in a band share top and height, run left
+// to right apart; bands run top to bottom apart.
+void assertBanded(const Region &region) {
+  const std::span<const Rect> rects = region.getRects();
+  for (std::size_t i = 1; i < rects.size(); ++i) {
+    const Rect &above = rects[i - 1];
+    const Rect &rect = rects[i];
+    if (above.y == rect.y)
+      assert(above.cy == rect.cy && above.x + above.cx < rect.x);
+    else
+      assert(above.y + above.cy <= rect.y);
+  }
+}
+
+Region randomRegion(std::mt19937 &random) {
+  Region region;
+  for (int i = static_cast<int>(random() % 6); i > 0; --i) {
+    const Rect rect{static_cast<int>(random() % 30), static_cast<int>(random() % 30),
+                    1 + static_cast<int>(random() % 10), 1 + static_cast<int>(random() % 10)};
+    if (random() % 3 != 0)
+      region |= Region(rect);
+    else
+      region -= Region(rect);
+  }
+  return region;
+}
+
+} // namespace
+
+extern "C" int test_region() {
+  std::mt19937 random(64);
+  for (int i = 0; i < 2000; ++i) {
+    const Region a = randomRegion(random);
+    const Region b = randomRegion(random);
+    const std::vector<char> inA = pixels(a);
+    const std::vector<char> inB = pixels(b);
+    const Region u = a | b;
+    const Region m = a & b;
+    const Region s = a - b;
+    assertBanded(u);
+    assertBanded(m);
+    assertBanded(s);
+    assert(u == (b | a));
+    const std::vector<char> inU = pixels(u);
+    const std::vector<char> inM = pixels(m);
+    const std::vector<char> inS = pixels(s);
+    for (int k = 0; k < n * n; ++k) {
+      assert(inU[k] == (inA[k] | inB[k]));
+      assert(inM[k] == (inA[k] & inB[k]));
+      assert(inS[k] == (inA[k] & !inB[k]));
+      assert(a.contains(k % n, k / n) == (inA[k] != 0));
+    }
+
+    // Blit through the region at random phases; bits outside the region
+    // or the clipped rectangle stay as they were.
+    std::vector<scanbyte> vSrc(((n + 7 + 7) / 8) * n);
+    for (scanbyte &v : vSrc)
+      v = static_cast<scanbyte>(random());
+    const BitPlane src(n + 7, n, vSrc.data());
+    std::vector<scanbyte> vDst(((n + 7) / 8) * n);
+    for (scanbyte &v : vDst)
+      v = static_cast<scanbyte>(random());
+    std::vector<scanbyte> vOld(vDst);
+    BitPlane dst(n, n, vDst.data());
+    const BitPlane old(n, n, vOld.data());
+    const int x = static_cast<int>(random() % 50) - 5;
+    const int y = static_cast<int>(random() % 50) - 5;
+    const int cx = static_cast<int>(random() % 40);
+    const int cy = static_cast<int>(random() % 40);
+    const int xSrc = static_cast<int>(random() % 20);
+    const int ySrc = static_cast<int>(random() % 10);
+    dst.bitBlt(a, x, y, cx, cy, src, xSrc, ySrc, srcCopy);
+    for (int yDst = 0; yDst < n; ++yDst)
+      for (int xDst = 0; xDst < n; ++xDst) {
+        const int xs = xDst - x + xSrc;
+        const int ys = yDst - y + ySrc;
+        const bool in = inA[yDst * n + xDst] != 0 && x <= xDst && xDst < x + cx && y <= yDst && yDst < y + cy &&
+                        xs < n + 7 && ys < n;
+        assert(pixel(dst, xDst, yDst) == (in ? pixel(src, xs, ys) : pixel(old, xDst, yDst)));
+      }
+  }
+  std::cout << "regions match pixel sets" << std::endl;
+  return 0;
+}
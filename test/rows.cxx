@@ -0,0 +1,98 @@
+#include <raster/bit_plane.hxx>
+#include "pixel.hxx"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace raster;
+
+namespace {
+
+using Image = std::vector<std::vector<bool>>;
+
+Image image(const BitPlane &bitPlane) {
+  Image pixels(bitPlane.getHeight(), std::vector<bool>(bitPlane.getWidth()));
+  for (int y = 0; y < bitPlane.getHeight(); ++y)
+    for (int x = 0; x < bitPlane.getWidth(); ++x)
+      pixels[y][x] = pixel(bitPlane, x, y);
+  return pixels;
+}
+
+void clear(Image::iterator first, Image::iterator last) {
+  for (; first != last; ++first)
+    std::fill(first->begin(), first->end(), false);
+}
+
+} // namespace
+
+// Row operations on an indexed plane must match the same operations on
+// an image's rows; blits into and out of the plane must see the rows in
+// their new order.
+extern "C" int test_rows() {
+  std::mt19937 random(70);
+  std::vector<scanbyte> vSrc(8 * 64 + 8);
+  for (scanbyte &v : vSrc)
+    v = static_cast<scanbyte>(random());
+  const BitPlane src(64, 64, vSrc.data());
+  for (int i = 0; i < 100; ++i) {
+    const int cx = 1 + static_cast<int>(random() % 60);
+    const int cy = 1 + static_cast<int>(random() % 60);
+    BitPlane bitPlane;
+    assert(bitPlane.create(cx, cy));
+    bitPlane.bitBlt(0, 0, cx, cy, src, static_cast<int>(random() % 4), 0, srcCopy);
+    assert(bitPlane.indexRows());
+    Image expected = image(bitPlane);
+    for (int j = 0; j < 20; ++j) {
+      const int y = static_cast<int>(random() % cy);
+      const int n = std::min(1 + static_cast<int>(random() % 4), cy - y);
+      switch (random() % 5) {
+      case 0: {
+        const int dy = static_cast<int>(random() % 100) - 50;
+        assert(bitPlane.scrollRows(dy));
+        std::rotate(expected.begin(), expected.end() - ((dy % cy) + cy) % cy, expected.end());
+        break;
+      }
+      case 1:
+        assert(bitPlane.insertRows(y, n));
+        std::rotate(expected.begin() + y, expected.end() - n, expected.end());
+        clear(expected.begin() + y, expected.begin() + y + n);
+        break;
+      case 2:
+        assert(bitPlane.deleteRows(y, n));
+        std::rotate(expected.begin() + y, expected.begin() + y + n, expected.end());
+        clear(expected.end() - n, expected.end());
+        break;
+      case 3: {
+        const int y1 = static_cast<int>(random() % cy);
+        assert(bitPlane.swapRows(y, y1));
+        std::swap(expected[y], expected[y1]);
+        break;
+      }
+      default:
+        assert(bitPlane.flipRows());
+        std::reverse(expected.begin(), expected.end());
+      }
+      assert(image(bitPlane) == expected);
+    }
+    std::vector<scanbyte> vOut(((cx + 7) / 8) * cy + 8);
+    BitPlane out(cx, cy, vOut.data());
+    out.bitBlt(0, 0, cx, cy, bitPlane, 0, 0, srcCopy);
+    assert(image(out) == expected);
+    assert(bitPlane.unindexRows());
+    assert(image(bitPlane) == expected);
+  }
+  // Creating an indexed plane afresh indexes the new scan lines without
+  // touching the old ones.
+  BitPlane recreated;
+  assert(recreated.create(64, 64) && recreated.indexRows() && recreated.scrollRows(3));
+  recreated.trackOccupancy();
+  assert(recreated.create(128, 128) && recreated.isIndexingRows());
+  assert(recreated.bitBlt(0, 0, 128, 128, whiteness));
+  assert(recreated.bitBlt(0, 0, 128, 128, dstInvert) && recreated.nextOccupiedRow(0) == 128);
+  assert(recreated.scrollRows(5) && recreated.unindexRows());
+  std::cout << "row tables match rows" << std::endl;
+  return 0;
+}
@@ -0,0 +1,64 @@
+#include <raster/summed_area_table.hxx>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace raster;
+
+namespace {
+
+std::uint32_t bruteCount(const std::vector<scanbyte> &v, int cx, int cy, int x, int y, int cxRect, int cyRect) {
+  const int widthScanBytes = (cx + 7) / 8;
+  std::uint32_t count = 0U;
+  for (int yPixel = std::max(y, 0); yPixel < std::min(y + cyRect, cy); ++yPixel)
+    for (int xPixel = std::max(x, 0); xPixel < std::min(x + cxRect, cx); ++xPixel)
+      if ((v[yPixel * widthScanBytes + (xPixel >> 3)] & (0x80U >> (xPixel & 7))) != 0)
+        ++count;
+  return count;
+}
+
+} // namespace
+
+// Rectangle counts must match brute-force counts, both after building
+// and after incremental updates following blits and fills.
+extern "C" int test_sat() {
+  std::mt19937 random(58);
+  for (int i = 0; i < 20; ++i) {
+    const int cx = 1 + static_cast<int>(random() % 200);
+    const int cy = 1 + static_cast<int>(random() % 40);
+    const int widthScanBytes = (cx + 7) / 8;
+    std::vector<scanbyte> v(widthScanBytes * cy + 8);
+    // Mix empty, full and random scan words.
+    for (scanbyte &b : v)
+      b = static_cast<scanbyte>(i % 3 == 0 ? 0U : i % 3 == 1 ? random() : random() & random() & random());
+    BitPlane bitPlane(cx, cy, v.data());
+    SummedAreaTable table;
+    assert(table.create(bitPlane));
+    for (int j = 0; j < 20; ++j) {
+      const int x = static_cast<int>(random() % (cx + 20)) - 10;
+      const int y = static_cast<int>(random() % (cy + 20)) - 10;
+      const int cxRect = static_cast<int>(random() % (cx + 20));
+      const int cyRect = static_cast<int>(random() % (cy + 20));
+      if (j % 2 == 0)
+        bitPlane.bitBlt(x, y, cxRect, cyRect, random() % 2 == 0 ? whiteness : dstInvert);
+      else
+        bitPlane.bitBlt(x, y, cxRect, cyRect, bitPlane, cxRect % 7, cyRect % 5, srcPaint);
+      table.update(bitPlane, x, y, cxRect, cyRect);
+      for (int k = 0; k < 50; ++k) {
+        const int xCount = static_cast<int>(random() % (cx + 10)) - 5;
+        const int yCount = static_cast<int>(random() % (cy + 10)) - 5;
+        const int cxCount = static_cast<int>(random() % (cx + 10));
+        const int cyCount = static_cast<int>(random() % (cy + 10));
+        assert(table.count(xCount, yCount, cxCount, cyCount) ==
+               bruteCount(v, cx, cy, xCount, yCount, cxCount, cyCount));
+      }
+    }
+    assert(table.count(0, 0, cx, cy) == bruteCount(v, cx, cy, 0, 0, cx, cy));
+  }
+  std::cout << "summed-area counts match brute-force counts" << std::endl;
+  return 0;
+}
@@ -0,0 +1,142 @@
+#include <raster/bit_plane.hxx>
+#include <raster/draw.hxx>
+#include "pixel.hxx"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace raster;
+
+namespace {
+
+// Reference ellipse: pixel dx, dy lies within radii rx, ry plus half a pixel.
+bool inside(int dx, int dy, int rx, int ry) {
+  if (rx < 0 || ry < 0)
+    return false;
+  const std::int64_t a = 2 * rx + 1;
+  const std::int64_t b = 2 * ry + 1;
+  return 4 * std::int64_t{dx} * dx * b * b + 4 * std::int64_t{dy} * dy * a * a <= a * a * b * b;
+}
+
+// Reference stroke: signed distance of pixel centre x, y beyond the
+// edge of a thick line; negative inside, positive outside.
+double beyond(double x, double y, int x0, int y0, int x1, int y1, int width, LineCap lineCap) {
+  const double half = width / 2.0;
+  const double dx = x1 - x0;
+  const double dy = y1 - y0;
+  const double length = std::hypot(dx, dy);
+  const double ux = length == 0 ? 1 : dx / length;
+  const double uy = length == 0 ? 0 : dy / length;
+  const double along = (x - x0) * ux + (y - y0) * uy;
+  const double across = std::abs((x - x0) * uy - (y - y0) * ux);
+  if (lineCap == LineCap::round) {
+    const double t = std::clamp(along, 0.0, length);
+    return std::hypot(x - (x0 + t * ux), y - (y0 + t * uy)) - half;
+  }
+  const double extend = lineCap == LineCap::square ? half : 0;
+  return std::max({across - half, -extend - along, along - length - extend});
+}
+
+} // namespace
+
+// Ellipses must fill the pixels within the reference ellipse; outlines
+// must be those filled pixels with a neighbour outside; arcs, rings and
+// thick lines must keep within their reference shapes.
+extern "C" int test_shape() {
+  std::mt19937 random(74);
+  const int cx = 96;
+  const int cy = 80;
+  std::vector<scanbyte> v(12 * cy);
+  BitPlane bitPlane(cx, cy, v.data());
+  for (int i = 0; i < 1000; ++i) {
+    const int x = static_cast<int>(random() % (cx + 40)) - 20;
+    const int y = static_cast<int>(random() % (cy + 40)) - 20;
+    const int rx = static_cast<int>(random() % 40);
+    const int ry = static_cast<int>(random() % 40);
+    std::fill(v.begin(), v.end(), 0U);
+    switch (random() % 5) {
+    case 0:
+      fillEllipse(bitPlane, x, y, rx, ry);
+      for (int yPixel = 0; yPixel < cy; ++yPixel)
+        for (int xPixel = 0; xPixel < cx; ++xPixel)
+          assert(pixel(bitPlane, xPixel, yPixel) == inside(xPixel - x, yPixel - y, rx, ry));
+      break;
+    case 1:
+      drawEllipse(bitPlane, x, y, rx, ry, srcInvert);
+      for (int yPixel = 0; yPixel < cy; ++yPixel)
+        for (int xPixel = 0; xPixel < cx; ++xPixel) {
+          const int dx = xPixel - x;
+          const int dy = yPixel - y;
+          const bool edge = inside(dx, dy, rx, ry) && (!inside(dx - 1, dy, rx, ry) || !inside(dx + 1, dy, rx, ry) ||
+                                                       !inside(dx, dy - 1, rx, ry) || !inside(dx, dy + 1, rx, ry));
+          assert(pixel(bitPlane, xPixel, yPixel) == edge);
+        }
+      break;
+    case 2: {
+      const double startAngle = static_cast<int>(random() % 720) - 360;
+      const double sweepAngle = static_cast<int>(random() % 720) - 360;
+      drawArc(bitPlane, x, y, rx, ry, startAngle, sweepAngle, srcInvert);
+      std::vector<scanbyte> vOutline(v.size(), 0U);
+      BitPlane outline(cx, cy, vOutline.data());
+      drawEllipse(outline, x, y, rx, ry);
+      for (int yPixel = 0; yPixel < cy; ++yPixel)
+        for (int xPixel = 0; xPixel < cx; ++xPixel)
+          assert(!pixel(bitPlane, xPixel, yPixel) || pixel(outline, xPixel, yPixel));
+      // The arc and its complement make up the whole outline.
+      if (sweepAngle < 0)
+        drawArc(bitPlane, x, y, rx, ry, startAngle, 360 + sweepAngle, srcPaint);
+      else
+        drawArc(bitPlane, x, y, rx, ry, startAngle + sweepAngle, 360 - sweepAngle, srcPaint);
+      assert(v == vOutline);
+      break;
+    }
+    case 3: {
+      const int width = 2 + static_cast<int>(random() % 8);
+      strokeEllipse(bitPlane, x, y, rx, ry, width, srcInvert);
+      const int rxOuter = rx + width / 2;
+      const int ryOuter = ry + width / 2;
+      for (int yPixel = 0; yPixel < cy; ++yPixel)
+        for (int xPixel = 0; xPixel < cx; ++xPixel) {
+          const int dx = xPixel - x;
+          const int dy = yPixel - y;
+          const bool ring = inside(dx, dy, rxOuter, ryOuter) && !inside(dx, dy, rxOuter - width, ryOuter - width);
+          assert(pixel(bitPlane, xPixel, yPixel) == ring);
+        }
+      break;
+    }
+    default: {
+      const int x1 = static_cast<int>(random() % (cx + 40)) - 20;
+      const int y1 = static_cast<int>(random() % (cy + 40)) - 20;
+      const int width = 1 + static_cast<int>(random() % 12);
+      const LineCap lineCap = static_cast<LineCap>(random() % 3);
+      const bool nothing = x == x1 && y == y1 && lineCap == LineCap::butt;
+      strokeLine(bitPlane, x, y, x1, y1, width, lineCap, srcInvert);
+      for (int yPixel = 0; yPixel < cy; ++yPixel)
+        for (int xPixel = 0; xPixel < cx; ++xPixel) {
+          const double distance = beyond(xPixel, yPixel, x, y, x1, y1, width, lineCap);
+          if (std::abs(distance) > 1e-9)
+            assert(pixel(bitPlane, xPixel, yPixel) == (distance < 0 && !nothing));
+        }
+    }
+    }
+  }
+
+  // Arcs far larger than the plane draw only their visible pixels: the
+  // top of a huge circle, split at its apex, still makes up the outline.
+  std::vector<scanbyte> vArc(8 * 64 + 8, 0U);
+  std::vector<scanbyte> vCircle(vArc.size(), 0U);
+  BitPlane arc(64, 64, vArc.data());
+  BitPlane circle(64, 64, vCircle.data());
+  assert(drawEllipse(circle, 32, 16032, 16000, 16000));
+  assert(drawArc(arc, 32, 16032, 16000, 16000, 90, 90));
+  assert(drawArc(arc, 32, 16032, 16000, 16000, 90, -90));
+  assert(!drawArc(arc, 32, 16032, 16000, 16000, 180, 180));
+  assert(vArc == vCircle);
+  std::cout << "shapes match reference shapes" << std::endl;
+  return 0;
+}
@@ -0,0 +1,71 @@
+#include <raster/bit_plane.hxx>
+#include "pixel.hxx"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace raster;
+
+// Shifts and rotations in place must match a pixel-by-pixel reference,
+// leave pixels outside the rectangle alone, and respect a clip mask.
+extern "C" int test_shift() {
+  std::mt19937 random(71);
+  for (int i = 0; i < 5000; ++i) {
+    const int cx = 1 + static_cast<int>(random() % 300);
+    const int cy = 1 + static_cast<int>(random() % 3);
+    std::vector<scanbyte> v(((cx + 7) / 8) * cy);
+    for (scanbyte &b : v)
+      b = static_cast<scanbyte>(random());
+    const std::vector<scanbyte> vOld(v);
+    std::vector<scanbyte> vMask(v.size());
+    for (scanbyte &b : vMask)
+      b = static_cast<scanbyte>(random());
+    BitPlane bitPlane(cx, cy, v.data());
+    const BitPlane old(cx, cy, const_cast<scanbyte *>(vOld.data()));
+    const BitPlane mask(cx, cy, vMask.data());
+    const bool clipping = random() % 4 == 0;
+    if (clipping)
+      bitPlane.setClipMask(&mask);
+    const int x = static_cast<int>(random() % (cx + 10)) - 5;
+    const int cxShift = static_cast<int>(random() % (cx + 10));
+    const int dx = static_cast<int>(random() % 200) - 100;
+    const bool wrap = random() % 2 == 0;
+    bitPlane.shiftBits(x, 0, cxShift, cy, dx, wrap);
+    const int x0 = std::max(x, 0);
+    const int x1 = std::min(x + cxShift, cx);
+    for (int y = 0; y < cy; ++y)
+      for (int xPixel = 0; xPixel < cx; ++xPixel) {
+        bool expected = pixel(old, xPixel, y);
+        if (x0 <= xPixel && xPixel < x1 && (!clipping || pixel(mask, xPixel, y))) {
+          int xFrom = xPixel - dx;
+          if (wrap)
+            xFrom = x0 + ((xFrom - x0) % (x1 - x0) + (x1 - x0)) % (x1 - x0);
+          expected = x0 <= xFrom && xFrom < x1 && pixel(old, xFrom, y);
+        }
+        assert(pixel(bitPlane, xPixel, y) == expected);
+      }
+  }
+  // Negative extents shift the same pixels as their positive equals.
+  for (int i = 0; i < 500; ++i) {
+    const int cx = 1 + static_cast<int>(random() % 200);
+    const int cy = 1 + static_cast<int>(random() % 4);
+    std::vector<scanbyte> v(((cx + 7) / 8) * cy);
+    for (scanbyte &b : v)
+      b = static_cast<scanbyte>(random());
+    std::vector<scanbyte> w(v);
+    BitPlane positive(cx, cy, v.data());
+    BitPlane negative(cx, cy, w.data());
+    const int x = static_cast<int>(random() % (cx + 10)) - 5;
+    const int cxShift = static_cast<int>(random() % (cx + 10));
+    const int dx = static_cast<int>(random() % 100) - 50;
+    const bool wrap = random() % 2 == 0;
+    assert(positive.shiftBits(x, 0, cxShift, cy, dx, wrap) ==
+           negative.shiftBits(x + cxShift, cy, -cxShift, -cy, dx, wrap));
+    assert(v == w);
+  }
+  std::cout << "shifts match pixel shifts" << std::endl;
+  return 0;
+}
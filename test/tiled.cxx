@@ -0,0 +1,123 @@
+#include <raster/bounds.hxx>
+#include <raster/dedup_plane.hxx>
+#include <raster/paged_plane.hxx>
+#include "pixel.hxx"
+
+#include <cassert>
+#include <climits>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace raster;
+
+namespace {
+
+// Planes over vectors with a spare word: blits may fetch one scan byte
+// past the end of a source rectangle.
+struct Plane {
+  Plane(int cx, int cy) : v(((cx + 7) / 8) * cy + 8, 0U), bitPlane(cx, cy, v.data()) {}
+  std::vector<scanbyte> v;
+  BitPlane bitPlane;
+};
+
+template <typename Tiled> void assertMatches(Tiled &tiled, const BitPlane &expected) {
+  Plane out(expected.getWidth(), expected.getHeight());
+  tiled.render(out.bitPlane, 0, 0, expected.getWidth(), expected.getHeight(), 0, 0, srcCopy);
+  for (int y = 0; y < expected.getHeight(); ++y)
+    for (int x = 0; x < expected.getWidth(); ++x)
+      assert(pixel(out.bitPlane, x, y) == pixel(expected, x, y));
+}
+
+// Random blits and fills land in the tiled plane and a reference plane
+// alike; the tiled plane must render the same pixels.  Negative extents
+// put the origins at the far edge.
+template <typename Tiled> void blitRandomly(std::mt19937 &random, Tiled &tiled, BitPlane &expected) {
+  Plane src(1 + static_cast<int>(random() % 120), 1 + static_cast<int>(random() % 120));
+  for (scanbyte &v : src.v)
+    v = static_cast<scanbyte>(random() & random());
+  for (int i = 0; i < 40; ++i) {
+    const int x = static_cast<int>(random() % 220) - 10;
+    const int y = static_cast<int>(random() % 220) - 10;
+    const int cx = static_cast<int>(random() % 300) - 150;
+    const int cy = static_cast<int>(random() % 300) - 150;
+    if (random() % 3 == 0) {
+      const Rop1 rop1 = random() % 3 == 0 ? dstInvert : random() % 2 == 0 ? blackness : whiteness;
+      tiled.bitBlt(x, y, cx, cy, rop1);
+      expected.bitBlt(x, y, cx, cy, rop1);
+    } else {
+      const int xSrc = static_cast<int>(random() % 100) - 10;
+      const int ySrc = static_cast<int>(random() % 100) - 10;
+      const Rop2 rop2 = static_cast<Rop2>(random() % 16);
+      tiled.bitBlt(x, y, cx, cy, src.bitPlane, xSrc, ySrc, rop2);
+      expected.bitBlt(x, y, cx, cy, src.bitPlane, xSrc, ySrc, rop2);
+    }
+  }
+  assertMatches(tiled, expected);
+}
+
+} // namespace
+
+extern "C" int test_tiled() {
+  std::mt19937 random(69);
+  for (int i = 0; i < 20; ++i) {
+    const int cx = 1 + static_cast<int>(random() % 200);
+    const int cy = 1 + static_cast<int>(random() % 200);
+    const int tileSize = 8 * (1 + static_cast<int>(random() % 8));
+
+    Plane expected(cx, cy);
+    DedupPlane dedup;
+    assert(dedup.create(cx, cy, tileSize));
+    assert(dedup.uniqueTileCount() == 1U);
+    blitRandomly(random, dedup, expected.bitPlane);
+
+    // Copies share tiles; writing one leaves the other alone.
+    const DedupPlane copy = dedup;
+    Plane before(cx, cy);
+    before.v = expected.v;
+    before.bitPlane = BitPlane(cx, cy, before.v.data());
+    blitRandomly(random, dedup, expected.bitPlane);
+    assert(copy.render(expected.bitPlane, 0, 0, cx, cy, 0, 0, srcCopy));
+    for (int y = 0; y < cy; ++y)
+      for (int x = 0; x < cx; ++x)
+        assert(pixel(expected.bitPlane, x, y) == pixel(before.bitPlane, x, y));
+
+    // Spill through a two-tile cache.
+    PagedPlane paged;
+    assert(paged.create(cx, cy, 2U, nullptr, tileSize));
+    assert(paged.bitBlt(0, 0, cx, cy, expected.bitPlane, 0, 0, srcCopy));
+    blitRandomly(random, paged, expected.bitPlane);
+    assert(paged.residentTileCount() <= 2U);
+    assert(paged.boundingBox() == boundingBox(expected.bitPlane));
+    assert(paged.boundingBox(false) == boundingBox(expected.bitPlane, false));
+  }
+
+  // Identical tiles share storage.
+  DedupPlane page;
+  assert(page.create(1024, 1024, 64));
+  Plane logo(64, 64);
+  logo.bitPlane.bitBlt(8, 8, 48, 48, whiteness);
+  for (int y = 0; y < 1024; y += 128)
+    for (int x = 0; x < 1024; x += 128)
+      page.bitBlt(x, y, 64, 64, logo.bitPlane, 0, 0, srcCopy);
+  assert(page.tileCount() == 256U);
+  assert(page.uniqueTileCount() == 2U);
+  assert(page.bitBlt(0, 0, 64, 64, blackness));
+  assert(page.uniqueTileCount() == 2U);
+
+  // Fills answer whether any tile changed.
+  assert(!page.bitBlt(0, 0, 64, 64, blackness));
+  assert(!page.bitBlt(64, 0, 64, 64, blackness));
+  assert(!page.bitBlt(136, 8, 48, 48, whiteness));
+  assert(page.bitBlt(136, 8, 49, 48, whiteness));
+  assert(!page.bitBlt(64, 64, -64, -64, blackness));
+  assert(page.bitBlt(0, 0, 1, 1, dstInvert));
+  assert(!page.bitBlt(-10, -10, 5, 5, whiteness));
+  // Grids whose tile bytes or tile count overflow refuse to create.
+  PagedPlane huge;
+  assert(!huge.create(INT_MAX, INT_MAX, 2U, nullptr, 8));
+  assert(!huge.create(64, 64, 2U, nullptr, INT_MAX));
+  assert(!page.create(64, 64, 1 << 17));
+  std::cout << "tiled planes match reference planes" << std::endl;
+  return 0;
+}
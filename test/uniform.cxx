@@ -0,0 +1,70 @@
+#include <raster/bit_plane.hxx>
+#include "pixel.hxx"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace raster;
+
+// Uniform-source detection must not change what any binary raster
+// operation writes, with or without detection, whether or not the
+// source tracks occupancy; every pixel must follow the truth table.
+extern "C" int test_uniform() {
+  std::mt19937 random(67);
+  const auto next = [&](int n) { return static_cast<int>(random() % n); };
+  for (int i = 0; i < 200; ++i) {
+    // Sources mix empty, full and random scan lines, some uniform only
+    // across part of their width.  Fetches may read one scan byte past
+    // the last, so the scan bytes carry spares.
+    const int cxSrc = 1 + next(300);
+    const int cySrc = 1 + next(40);
+    std::vector<scanbyte> v((cxSrc + 7) / 8 * cySrc + 8);
+    BitPlane src(cxSrc, cySrc, v.data());
+    for (int y = 0; y < src.getHeight(); ++y) {
+      const int kind = next(4);
+      for (int x = 0; x < src.getWidth(); x += 8)
+        *src.bits(x, y) = kind == 0 ? 0x00U : kind == 1 ? 0xffU : static_cast<scanbyte>(random());
+      if (kind == 3)
+        src.bitBlt(next(src.getWidth()), y, next(src.getWidth()), 1, next(2) == 0 ? blackness : whiteness);
+    }
+    BitPlane dst;
+    assert(dst.create(1 + next(300), 1 + next(40)));
+    for (int y = 0; y < dst.getHeight(); ++y)
+      for (int x = 0; x < dst.getWidth(); x += 8)
+        *dst.bits(x, y) = static_cast<scanbyte>(random());
+
+    const int x = next(dst.getWidth());
+    const int y = next(dst.getHeight());
+    const int xSrc = next(src.getWidth());
+    const int ySrc = next(src.getHeight());
+    const int cx = std::min(dst.getWidth() - x, src.getWidth() - xSrc);
+    const int cy = std::min(dst.getHeight() - y, src.getHeight() - ySrc);
+    for (int rop = 0; rop < 16; ++rop)
+      for (int variant = 0; variant < 4; ++variant) {
+        const bool detect = (variant & 1) != 0;
+        const bool track = (variant & 2) != 0;
+        if (track)
+          src.trackOccupancy();
+        else
+          src.untrackOccupancy();
+        BitPlane out(dst);
+        out.detectUniformSources(detect);
+        assert(out.bitBlt(x, y, cx, cy, src, xSrc, ySrc, static_cast<Rop2>(rop)));
+        for (int yOut = 0; yOut < out.getHeight(); ++yOut)
+          for (int xOut = 0; xOut < out.getWidth(); ++xOut) {
+            const bool d = pixel(dst, xOut, yOut);
+            bool expected = d;
+            if (xOut >= x && xOut < x + cx && yOut >= y && yOut < y + cy) {
+              const bool s = pixel(src, xSrc + xOut - x, ySrc + yOut - y);
+              expected = ((rop >> (2 * s + d)) & 1) != 0;
+            }
+            assert(pixel(out, xOut, yOut) == expected);
+          }
+      }
+  }
+  std::cout << "uniform-source detection matches the truth table" << std::endl;
+  return 0;
+}